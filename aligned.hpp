@@ -0,0 +1,61 @@
+// Implements an allocator that aligns memory to cache lines.
+
+#ifndef __Aligned_HPP__
+#define __Aligned_HPP__
+
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+// The size of a cache line in bytes.
+constexpr size_t CacheLineSize = 64;
+
+
+// Allocator for standard containers that aligns memory to cache lines.
+template<typename T>
+class AlignedAllocator
+{
+public:
+
+    typedef T value_type;
+
+
+    // Constructors.
+    AlignedAllocator() = default;
+
+    template<typename X>
+    AlignedAllocator(const AlignedAllocator<X>&) { /* Nothing. */ }
+
+
+    // Allocates memory for n objects.
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>
+        (
+            ::operator new(n * sizeof(T), std::align_val_t(CacheLineSize))
+        );
+    }
+
+    // Frees memory allocated by allocate().
+    void deallocate(T* ptr, size_t)
+    {
+        ::operator delete(ptr, std::align_val_t(CacheLineSize));
+    }
+
+
+    // All instances are interchangeable.
+    template<typename X>
+    bool operator==(const AlignedAllocator<X>&) const { return true; }
+
+    template<typename X>
+    bool operator!=(const AlignedAllocator<X>&) const { return false; }
+};
+
+
+// A vector whose data starts at a cache line.
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+#endif
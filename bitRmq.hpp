@@ -0,0 +1,135 @@
+// Implements functions to find minima in +-1 sequences of up to 64 elements
+// that are encoded in a single machine word, and other bit operations on
+// words.
+// A sequence x_0, x_1, ..., x_{len - 1} is encoded by a word whose bit k
+// (1 <= k < len) is set if x_k = x_{k - 1} - 1 and cleared if x_k = x_{k - 1} + 1.
+// Bit 0 is ignored. The functions only use bit operations; they do not need
+// any lookup tables.
+
+#ifndef __BitRmq_HPP__
+#define __BitRmq_HPP__
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+// Returns x_p - x_0 for the sequence encoded by the given word.
+inline int64_t bitExcess(uint64_t down, size_t p)
+{
+    // Steps 1, ..., p. Note that 2 << 63 overflows to 0, which results in
+    // the correct mask for p = 63.
+    uint64_t mask = (uint64_t(2) << p) - 2;
+
+    return int64_t(p) - 2 * int64_t(__builtin_popcountll(down & mask));
+}
+
+// Returns the position of the first minimum in x_0, ..., x_{len - 1} for the
+// sequence encoded by the given word. Requires 0 < len <= 64.
+inline size_t bitArgmin(uint64_t down, size_t len)
+{
+    constexpr uint64_t Ones = 0x0101010101010101;
+    constexpr uint64_t High = 0x8080808080808080;
+
+    // Bit 0 is no step. Treat all steps after the sequence as +1; then none of
+    // the positions after the sequence can be a first minimum.
+    down &= ~uint64_t(1);
+    if (len < 64) down &= (uint64_t(1) << len) - 1;
+
+    // With bit 0 cleared, position p has the value
+    //     S(p) = (p + 1) - 2 popcount(down & (2^{p + 1} - 1)) = x_p - x_0 + 1.
+    // Split the word into 8 lanes of one byte each. Lane m contains the
+    // positions 8m, ..., 8m + 7. First, determine for all lanes in parallel
+    // the first minimum of the sums S(p) - S(8m - 1) within the lane.
+    // All values are biased by 8 to keep them positive.
+
+    uint64_t run = Ones * 8;
+    uint64_t min = Ones * 127;
+    uint64_t pos = 0;
+
+    for (uint64_t t = 0; t < 8; t++)
+    {
+        // Add +1 or -1 to each lane.
+        uint64_t bit = (down >> t) & Ones;
+        run = run + Ones - (bit << 1);
+
+        // Lanes in which the new sum is smaller than the minimum, i.e., in
+        // which min >= run + 1.
+        uint64_t less = ((min | High) - (run + Ones)) & High;
+        uint64_t mask = (less >> 7) * 0xFF;
+
+        min = (min & ~mask) | (run & mask);
+        pos = (pos & ~mask) | ((Ones * t) & mask);
+    }
+
+
+    // Combine the lanes. Lane m of the exclusive prefix sum of run contains
+    // S(8m - 1) + 8m. Hence, lane m of val contains the minimum of lane m
+    // biased by 64, i.e., min_m - 8 + S(8m - 1) + 64. All intermediate values
+    // are in [0, 256); no lane overflows into another. Lanes after the
+    // sequence only contain +1 steps and cannot be smaller than the lane
+    // that contains the end of the sequence.
+    constexpr uint64_t LaneBias = 0x3830282018100800; // 8m in lane m
+
+    uint64_t val = ((run * Ones) << 8) + min + Ones * 56 - LaneBias;
+
+    // Find the first lane with the smallest value. Each key stores the lane
+    // in its lowest bits to prefer earlier lanes.
+    uint64_t key = ((val & 0xFF) << 3);
+    for (uint64_t m = 1; m < 8; m++)
+    {
+        uint64_t mKey = (((val >> (8 * m)) & 0xFF) << 3) | m;
+        key = mKey < key ? mKey : key;
+    }
+
+    size_t lane = key & 7;
+    return 8 * lane + ((pos >> (8 * lane)) & 0xFF);
+}
+
+
+// Reverses the order of the bits in the given word.
+inline uint64_t bitReverse(uint64_t w)
+{
+    w = ((w >> 1) & 0x5555555555555555) | ((w & 0x5555555555555555) << 1);
+    w = ((w >> 2) & 0x3333333333333333) | ((w & 0x3333333333333333) << 2);
+    w = ((w >> 4) & 0x0F0F0F0F0F0F0F0F) | ((w & 0x0F0F0F0F0F0F0F0F) << 4);
+
+    return __builtin_bswap64(w);
+}
+
+// Returns the position of the last minimum in x_0, ..., x_{len - 1} for the
+// sequence encoded by the given word. Requires 0 < len <= 64.
+inline size_t bitArgminLast(uint64_t down, size_t len)
+{
+    // The reversed sequence y_q = x_{len - 1 - q} has a down step at q if and
+    // only if x has an up step at len - q. Its first minimum is the last
+    // minimum of x.
+    uint64_t rev = bitReverse(~down);
+    rev = len == 64 ? rev << 1 : rev >> (63 - len);
+
+    return len - 1 - bitArgmin(rev, len);
+}
+
+// Returns the position of the r-th set bit (starting at 0) in the given word.
+// Requires that the word has more than r set bits.
+inline size_t bitSelect(uint64_t w, size_t r)
+{
+    size_t offset = 0;
+
+    // Find the byte.
+    for (;; offset += 8)
+    {
+        size_t count = __builtin_popcountll(w & 0xFF);
+        if (r < count) break;
+
+        r -= count;
+        w >>= 8;
+    }
+
+    // Remove the lower set bits in that byte.
+    for (; r > 0; r--) w &= w - 1;
+
+    return offset + __builtin_ctzll(w);
+}
+
+#endif
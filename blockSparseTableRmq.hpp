@@ -0,0 +1,159 @@
+// Represents a RMQ that uses a sparse table over blocks to run queries.
+// The data is split into blocks that each fill one cache line. Each block
+// stores the position of the minimum of each of its prefixes and suffixes, and
+// a sparse table over the block minima handles the blocks in between. Queries
+// within a single block scan it with vector instructions (see simdArgmin());
+// a whole block is one AVX-512 vector, and ranges of at least 16 bytes use at
+// least one SSE vector.
+// Unlike PlusMinusRMQ, it works for arbitrary data.
+// Runtime: O(n) | O(1)
+
+#ifndef __BlockSparseTableRmq_HPP__
+#define __BlockSparseTableRmq_HPP__
+
+
+#include <algorithm>
+#include <cstdint>
+
+#include "rmq.hpp"
+#include "simdArgmin.hpp"
+#include "sparseTableRmq.hpp"
+
+
+template
+<
+    typename T,
+    // The number of elements in a block. By default, a block fills one cache
+    // line of 64 bytes.
+    size_t B = std::max<size_t>(64 / sizeof(T), 2)
+>
+class BlockSparseTableRMQ : public RMQ<T>
+{
+    static_assert(B >= 2 && B <= 256, "Positions within blocks have to fit into a byte.");
+
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    BlockSparseTableRMQ(const std::vector<T>& data) : RMQ<T>(data), tableRmq(blockMinVal) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        const vector<T>& data = this->data;
+        const size_t n = data.size();
+
+        const size_t blockCount = (n + B - 1) / B;
+
+        prefix.resize(n);
+        suffix.resize(n);
+        blockMinVal.resize(blockCount);
+
+        for (size_t b = 0; b < blockCount; b++)
+        {
+            const size_t bSta = b * B;
+            const size_t bEnd = std::min(bSta + B, n);
+
+            // Positions of the minima relative to the start of the block.
+            prefix[bSta] = 0;
+            for (size_t k = bSta + 1; k < bEnd; k++)
+            {
+                size_t prv = bSta + prefix[k - 1];
+                prefix[k] = uint8_t(data[k] < data[prv] ? k - bSta : prv - bSta);
+            }
+
+            suffix[bEnd - 1] = uint8_t(bEnd - 1 - bSta);
+            for (size_t k = bEnd - 1; k > bSta; k--)
+            {
+                size_t nxt = bSta + suffix[k];
+                suffix[k - 1] = uint8_t(data[k - 1] <= data[nxt] ? k - 1 - bSta : nxt - bSta);
+            }
+
+            blockMinVal[b] = data[bSta + suffix[bSta]];
+        }
+
+        // Create RMQ over blocks.
+        tableRmq.processData();
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        const vector<T>& data = this->data;
+
+        // Determine block indices.
+        size_t iB = i / B;
+        size_t jB = j / B;
+
+        if (iB == jB)
+        {
+            // i and j are in the same block.
+            return i + simdArgmin(data.data() + i, j - i + 1);
+        }
+
+
+        // i and j are in different blocks.
+        size_t iMin = iB * B + suffix[i];
+        size_t jMin = jB * B + prefix[j];
+        size_t ijMin = this->minIndex(iMin, jMin);
+
+        // Are blocks adjacent?
+        if (iB + 1 == jB) return ijMin;
+
+
+        // Determine the minimum in the blocks between i and j.
+        size_t b = staticQuery(tableRmq, iB + 1, jB - 1);
+
+        if (data[ijMin] < blockMinVal[b]) return ijMin;
+        else return b * B + suffix[b * B];
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the blocks of a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+                prefetch(&suffix[r.first]);
+                prefetch(&prefix[r.second]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = BlockSparseTableRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The position of the minimum from the start of each element's block to
+    // the element, relative to the start of the block.
+    vector<uint8_t> prefix;
+
+    // The position of the minimum from each element to the end of its block,
+    // relative to the start of the block.
+    vector<uint8_t> suffix;
+
+    // The minimum of each block.
+    vector<T> blockMinVal;
+
+    // A RMQ to find the minimum block.
+    SparseTableRMQ<T, uint32_t> tableRmq;
+
+};
+
+#endif
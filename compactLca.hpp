@@ -0,0 +1,126 @@
+// Defines an algorithm to find the lowest common ancestor of two nodes in a
+// tree with less memory than LCA<>. It uses a CompactEulerTour, i.e., 32-bit
+// node IDs and one bit per level, and runs PlusMinusWordRMQ directly on the
+// steps of the tour. Hence, the levels are never stored.
+// Runtime: O(n) | O(1)
+
+
+#ifndef __CompactLCA_HPP__
+#define __CompactLCA_HPP__
+
+#include <algorithm>
+
+#include "plusMinusWordRmq.hpp"
+#include "tree.h"
+
+
+class CompactLCA
+{
+
+public:
+
+    // Default constructor.
+    CompactLCA() = default;
+
+    // Constructor.
+    CompactLCA(const Tree& tree) : tree(&tree) { }
+
+    // Constructor.
+    // Uses the given Euler tour instead of computing it from a tree.
+    CompactLCA(CompactEulerTour&& et) : et(std::move(et)) { }
+
+    ~CompactLCA()
+    {
+        if (rmqPtr != nullptr) delete rmqPtr;
+    }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        if (tree != nullptr) et = tree->compactEulerTour();
+
+        if (rmqPtr != nullptr) delete rmqPtr;
+        rmqPtr = new PlusMinusWordRMQ<uint32_t>(et.steps, et.E.size(), 1);
+        rmqPtr->processData();
+    };
+
+    // Determines the lowest common ancestor of the given nodes.
+    // Behaviour is undefined if a node does not exist or pre-processing has
+    // not been done.
+    size_t operator()(size_t uId, size_t vId) const
+    {
+        const size_t rU = et.R[uId];
+        const size_t rV = et.R[vId];
+
+        // LCA(u, v) = E[rmq(R[u], R[v])]
+        return et.E[staticQuery(*rmqPtr, std::min(rU, rV), std::max(rU, rV))];
+    };
+
+    // Determines the lowest common ancestor for each of the given node pairs
+    // and writes it into results[], i.e., results[q] is the LCA of pairs[q].
+    // Pairs are processed in chunks as by LCA::batch().
+    void batch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results) const
+    {
+        constexpr size_t ChunkSize = 256;
+        constexpr size_t Prefetch  = 8;
+
+        std::pair<size_t, size_t> ranges[ChunkSize];
+        size_t minIdx[ChunkSize];
+        size_t slots[ChunkSize];
+
+        for (size_t sta = 0; sta < count; sta += ChunkSize)
+        {
+            const size_t len = std::min(ChunkSize, count - sta);
+            const std::pair<size_t, size_t>* chunk = pairs + sta;
+
+            // Map nodes to positions in the Euler tour. Pairs with u == v are
+            // answered directly.
+            size_t used = 0;
+
+            for (size_t q = 0; q < len; q++)
+            {
+                if (q + Prefetch < len)
+                {
+                    prefetch(&et.R[chunk[q + Prefetch].first]);
+                    prefetch(&et.R[chunk[q + Prefetch].second]);
+                }
+
+                const size_t rU = et.R[chunk[q].first];
+                const size_t rV = et.R[chunk[q].second];
+
+                if (rU == rV)
+                {
+                    results[sta + q] = chunk[q].first;
+                    continue;
+                }
+
+                ranges[used].first  = std::min(rU, rV);
+                ranges[used].second = std::max(rU, rV);
+                slots[used++] = q;
+            }
+
+            rmqPtr->PlusMinusWordRMQ<uint32_t>::batch(ranges, used, minIdx);
+
+            // Map positions back to nodes.
+            for (size_t q = 0; q < used; q++)
+            {
+                if (q + Prefetch < used) prefetch(&et.E[minIdx[q + Prefetch]]);
+
+                results[sta + slots[q]] = et.E[minIdx[q]];
+            }
+        }
+    }
+
+private:
+
+    // The tree, if the Euler tour still needs to be computed.
+    const Tree* tree = nullptr;
+
+    CompactEulerTour et;
+
+    PlusMinusWordRMQ<uint32_t>* rmqPtr = nullptr;
+
+};
+
+#endif
@@ -0,0 +1,184 @@
+// Defines an algorithm to find the lowest common ancestor of two nodes in a
+// tree using a given RMQ algorithm on n elements instead of the 2n - 1
+// elements of an Euler tour.
+// The nodes are numbered in DFS order (pre-order), and the element at
+// position k is the number of the parent of the k-th node. Let u and v be two
+// different nodes with pre(u) < pre(v). Each node w with
+// pre(u) < pre(w) <= pre(v) is in the subtree of LCA(u, v), and the child of
+// LCA(u, v) on the path to v is such a node. Hence, the smallest element in
+// the range [pre(u) + 1, pre(v)] is the number of LCA(u, v).
+// Runtime: O(n) + RMQ | RMQ
+
+
+#ifndef __DfsLCA_HPP__
+#define __DfsLCA_HPP__
+
+#include <algorithm>
+
+#include "rmq.hpp"
+#include "tree.h"
+
+
+template
+<
+    typename T,
+    // Only allow RMQ algorithms on size_t.
+    typename = typename std::enable_if
+    <
+        std::is_base_of<RMQ<size_t>, T>::value,
+        T
+    >::type
+>
+class DfsLCA
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    DfsLCA(const Tree& tree) : tree(tree) { }
+
+    ~DfsLCA()
+    {
+        if (rmqPtr != nullptr) delete rmqPtr;
+    }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        const size_t n = tree.size();
+
+        pre.resize(n);
+        order.resize(n);
+        parentPre.resize(n);
+
+        // Number nodes in DFS order. Children are pushed in reverse order to
+        // visit them in the same order as Tree::eulerTour().
+        {
+            vector<size_t> stack;
+            stack.push_back(tree.getRoot());
+
+            for (size_t k = 0; stack.size() > 0; k++)
+            {
+                size_t vId = stack.back();
+                stack.pop_back();
+
+                pre[vId] = k;
+                order[k] = vId;
+
+                Span<size_t> children = tree[vId];
+                for (size_t c = children.size(); c > 0; c--)
+                {
+                    stack.push_back(children[c - 1]);
+                }
+            }
+        }
+
+        // The root has no parent; its element is never part of a query.
+        parentPre[0] = 0;
+        for (size_t k = 1; k < n; k++)
+        {
+            parentPre[k] = pre[tree(order[k])];
+        }
+
+        if (rmqPtr != nullptr) delete rmqPtr;
+        rmqPtr = new T(parentPre);
+        rmqPtr->processData();
+    };
+
+    // Determines the lowest common ancestor of the given nodes.
+    // Behaviour is undefined if a node does not exist or pre-processing has
+    // not been done.
+    size_t operator()(size_t uId, size_t vId) const
+    {
+        if (uId == vId) return uId;
+
+        const size_t& pU = pre[uId];
+        const size_t& pV = pre[vId];
+
+        // See top of file.
+        size_t i = std::min(pU, pV) + 1;
+        size_t j = std::max(pU, pV);
+
+        const T& rmq = *rmqPtr;
+        return order[parentPre[staticQuery(rmq, i, j)]];
+    };
+
+    // Determines the lowest common ancestor for each of the given node pairs
+    // and writes it into results[], i.e., results[q] is the LCA of pairs[q].
+    // Pairs are processed in chunks as by LCA::batch(): first all DFS number
+    // lookups, then one RMQ batch, then all parent lookups.
+    void batch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results) const
+    {
+        constexpr size_t ChunkSize = 256;
+        constexpr size_t Prefetch  = 8;
+
+        std::pair<size_t, size_t> ranges[ChunkSize];
+        size_t minIdx[ChunkSize];
+        size_t slots[ChunkSize];
+
+        for (size_t sta = 0; sta < count; sta += ChunkSize)
+        {
+            const size_t len = std::min(ChunkSize, count - sta);
+            const std::pair<size_t, size_t>* chunk = pairs + sta;
+
+            // Map nodes to ranges of DFS numbers. Pairs with u == v are
+            // answered directly.
+            size_t used = 0;
+
+            for (size_t q = 0; q < len; q++)
+            {
+                if (q + Prefetch < len)
+                {
+                    prefetch(&pre[chunk[q + Prefetch].first]);
+                    prefetch(&pre[chunk[q + Prefetch].second]);
+                }
+
+                if (chunk[q].first == chunk[q].second)
+                {
+                    results[sta + q] = chunk[q].first;
+                    continue;
+                }
+
+                const size_t& pU = pre[chunk[q].first];
+                const size_t& pV = pre[chunk[q].second];
+
+                // See top of file.
+                ranges[used].first  = std::min(pU, pV) + 1;
+                ranges[used].second = std::max(pU, pV);
+                slots[used++] = q;
+            }
+
+            rmqPtr->T::batch(ranges, used, minIdx);
+
+            // Map positions back to nodes.
+            for (size_t q = 0; q < used; q++)
+            {
+                if (q + Prefetch < used) prefetch(&parentPre[minIdx[q + Prefetch]]);
+
+                results[sta + slots[q]] = order[parentPre[minIdx[q]]];
+            }
+        }
+    }
+
+private:
+
+    const Tree& tree;
+
+    // The DFS number of each node.
+    vector<size_t> pre;
+
+    // The node with each DFS number.
+    vector<size_t> order;
+
+    // The DFS number of the parent of each node, ordered by DFS number.
+    vector<size_t> parentPre;
+
+    T* rmqPtr = nullptr;
+
+};
+
+#endif
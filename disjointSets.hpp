@@ -0,0 +1,80 @@
+// Implements disjoint sets (union-find) of the numbers 0, ..., n - 1 as used
+// by the offline algorithms. Each set is represented by one of its elements.
+// The caller decides which element represents the merged set; internally, the
+// smaller tree is attached to the larger one (union by size), and each root
+// stores the representative of its set. Together with path halving, this
+// gives an amortized runtime of O(alpha(n)) per operation.
+
+#ifndef __DisjointSets_HPP__
+#define __DisjointSets_HPP__
+
+
+#include <vector>
+
+
+class DisjointSets
+{
+
+public:
+
+    // Constructor.
+    // Creates n sets with one element each.
+    DisjointSets(size_t n) : parent(n), size(n, 1), label(n)
+    {
+        for (size_t x = 0; x < n; x++)
+        {
+            parent[x] = x;
+            label[x] = x;
+        }
+    }
+
+
+    // Returns the representative of the set that contains x.
+    size_t find(size_t x)
+    {
+        return label[root(x)];
+    }
+
+    // Merges the sets that contain a and b. b represents the result.
+    void link(size_t a, size_t b)
+    {
+        size_t rA = root(a);
+        size_t rB = root(b);
+
+        if (rA == rB) return;
+
+        if (size[rA] > size[rB]) std::swap(rA, rB);
+
+        parent[rA] = rB;
+        size[rB] += size[rA];
+        label[rB] = b;
+    }
+
+
+private:
+
+    std::vector<size_t> parent;
+
+    // The number of elements in the tree of each root.
+    std::vector<size_t> size;
+
+    // The representative of the set of each root.
+    std::vector<size_t> label;
+
+
+    // Returns the root of the tree that contains x.
+    // Halves the path to the root on the way.
+    size_t root(size_t x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+
+        return x;
+    }
+
+};
+
+#endif
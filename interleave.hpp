@@ -0,0 +1,43 @@
+// Implements a helper to run many independent tasks in an interleaved way
+// (asynchronous memory access chaining, AMAC). Each task is a state machine
+// whose steps each touch memory that the previous step prefetched. Switching
+// to another task after each step gives the prefetches time to complete;
+// hence, the cache misses of several tasks overlap instead of stalling the
+// CPU one after another.
+
+#ifndef __Interleave_HPP__
+#define __Interleave_HPP__
+
+
+#include <algorithm>
+
+
+// Runs the tasks 0, ..., count - 1 with up to W of them in flight at once.
+// init(state, t) starts task t and should prefetch the memory its first step
+// needs. step(state) runs the next step of a task; it returns true once the
+// task is finished.
+template<size_t W, typename State, typename Init, typename Step>
+void interleave(size_t count, Init init, Step step)
+{
+    State slots[W];
+
+    size_t active = std::min(W, count);
+    size_t next = 0;
+
+    for (; next < active; next++) init(slots[next], next);
+
+    for (size_t s = 0; active > 0; )
+    {
+        if (step(slots[s]))
+        {
+            // Start the next task in this slot. If there is none, move the
+            // last active task into it.
+            if (next < count) init(slots[s], next++);
+            else slots[s] = slots[--active];
+        }
+
+        if (++s >= active) s = 0;
+    }
+}
+
+#endif
@@ -5,6 +5,9 @@
 #ifndef __LCA_HPP__
 #define __LCA_HPP__
 
+#include <algorithm>
+
+#include "parallel.hpp"
 #include "rmq.hpp"
 #include "tree.h"
 
@@ -27,7 +30,13 @@ public:
     // Default constructor.
     LCA() = default;
 
-    LCA(const Tree& tree) : tree(tree) { }
+    // Constructor.
+    LCA(const Tree& tree) : tree(&tree) { }
+
+    // Constructor.
+    // Uses the given Euler tour instead of computing it from a tree. That
+    // allows to free the tree before pre-processing.
+    LCA(EulerTour&& et) : et(std::move(et)) { }
 
     ~LCA()
     {
@@ -38,11 +47,20 @@ public:
     // Pre-processes the data to allow queries.
     void processData()
     {
-        et = tree.eulerTour();
+        if (tree != nullptr) et = tree->eulerTour(threadCount);
+
+        if (rmqPtr != nullptr) delete rmqPtr;
         rmqPtr = new T(et.L);
         rmqPtr->processData();
     };
 
+    // Sets how many threads the computation of the Euler tour uses.
+    // By default, it uses one thread per core.
+    void setThreadCount(size_t count)
+    {
+        threadCount = std::max<size_t>(count, 1);
+    }
+
     // Performs a query on the given data and given range.
     // Returns the index of the minimum in that range.
     // Behaviour is undefined if the given range is invalid or pre-processing
@@ -61,18 +79,93 @@ public:
         // size_t j = rU ^ ((rU ^ rV) & -(rU < rV)); // max(rV, rU)
 
         // LCA(u, v) = E[rmq(R[u], R[v])]
-        T& rmq = *rmqPtr;
-        return et.E[rmq(i, j)];
+        const T& rmq = *rmqPtr;
+        return et.E[staticQuery(rmq, i, j)];
     };
 
+    // Determines the lowest common ancestor for each of the given node pairs
+    // and writes it into results[], i.e., results[q] is the LCA of pairs[q].
+    // Pairs are processed in chunks: first all R[] lookups, then one RMQ batch
+    // over the whole chunk, then all E[] lookups.
+    void batch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results) const
+    {
+        chunkedBatch(pairs, count, results, false);
+    }
+
+    // Same as batch(), but runs the RMQ of each chunk with
+    // RMQ::interleavedBatch().
+    void interleavedBatch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results) const
+    {
+        chunkedBatch(pairs, count, results, true);
+    }
+
 private:
 
-    const Tree& tree;
+    // The tree, if the Euler tour still needs to be computed.
+    const Tree* tree = nullptr;
 
     EulerTour et;
 
+    // The number of threads used for pre-processing.
+    size_t threadCount = defaultThreadCount();
+
     T* rmqPtr = nullptr;
 
+
+    // Implements batch() and interleavedBatch().
+    void chunkedBatch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results, bool interleaved) const
+    {
+        constexpr size_t ChunkSize = 256;
+        constexpr size_t Prefetch  = 8;
+
+        std::pair<size_t, size_t> ranges[ChunkSize];
+        size_t minIdx[ChunkSize];
+        size_t slots[ChunkSize];
+
+        for (size_t sta = 0; sta < count; sta += ChunkSize)
+        {
+            const size_t len = std::min(ChunkSize, count - sta);
+            const std::pair<size_t, size_t>* chunk = pairs + sta;
+
+            // Map nodes to positions in the Euler tour. Pairs with u == v are
+            // answered directly, since not every RMQ supports ranges [i, i].
+            size_t used = 0;
+
+            for (size_t q = 0; q < len; q++)
+            {
+                if (q + Prefetch < len)
+                {
+                    prefetch(&et.R[chunk[q + Prefetch].first]);
+                    prefetch(&et.R[chunk[q + Prefetch].second]);
+                }
+
+                const size_t& rU = et.R[chunk[q].first];
+                const size_t& rV = et.R[chunk[q].second];
+
+                if (rU == rV)
+                {
+                    results[sta + q] = chunk[q].first;
+                    continue;
+                }
+
+                ranges[used].first  = std::min(rU, rV);
+                ranges[used].second = std::max(rU, rV);
+                slots[used++] = q;
+            }
+
+            if (interleaved) rmqPtr->T::interleavedBatch(ranges, used, minIdx);
+            else rmqPtr->T::batch(ranges, used, minIdx);
+
+            // Map positions back to nodes.
+            for (size_t q = 0; q < used; q++)
+            {
+                if (q + Prefetch < used) prefetch(&et.E[minIdx[q + Prefetch]]);
+
+                results[sta + slots[q]] = et.E[minIdx[q]];
+            }
+        }
+    }
+
 };
 
 #endif
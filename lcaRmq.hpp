@@ -30,8 +30,8 @@ public:
     // Pre-processes the data to allow queries.
     void processData()
     {
-        Tree t = buildTree();
-        lca = new LCA<PlusMinusRMQ<size_t>>(t);
+        if (lca != nullptr) delete lca;
+        lca = new LCA<PlusMinusRMQ<size_t>>(eulerTour());
         lca->processData();
     }
 
@@ -44,6 +44,13 @@ public:
         return (*lca)(i, j);
     }
 
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        lca->batch(ranges, count, results);
+    }
+
 
 private:
 
@@ -51,31 +58,109 @@ private:
     LCA<PlusMinusRMQ<size_t>>* lca = nullptr;
 
 
-    // Helper function that builds a Cartesian Tree from the given data.
-    Tree buildTree()
+    // Represents a null pointer.
+    static constexpr size_t NullNode = -1;
+
+
+    // Helper function that computes an Euler tour of the Cartesian Tree of
+    // the given data. It does not create a Tree; it only determines the
+    // parent and children of each node and then walks along them.
+    EulerTour eulerTour() const
     {
-        const vector<T> data = this->data;
-        const size_t    n    = this->data.size();
+        const vector<T>& data = this->data;
+        const size_t     n    = this->data.size();
+
 
+        // --- Build Cartesian Tree. ---
 
-        vector<size_t> par(n, Tree::NullNode);
+        // The parent of each node also forms the stack of the right-most
+        // path while building the tree.
+        vector<size_t> par(n, NullNode);
+        vector<size_t> left(n, NullNode);
+        vector<size_t> right(n, NullNode);
+
+        size_t root = n > 0 ? 0 : NullNode;
 
         for (size_t i = 1; i < n; i++)
         {
-            size_t lar = i;
+            size_t lar = NullNode;
             size_t sml = i - 1;
 
-            while (sml != Tree::NullNode && data[i] < data[sml])
+            while (sml != NullNode && data[i] < data[sml])
             {
                 lar = sml;
                 sml = par[sml];
             }
 
-            par[lar] = i;
+            // The removed path becomes the left subtree of i.
+            if (lar != NullNode)
+            {
+                par[lar] = i;
+                left[i] = lar;
+            }
+
             par[i] = sml;
+
+            if (sml != NullNode) right[sml] = i;
+            else root = i;
+        }
+
+
+        // --- Compute Euler tour. ---
+
+        // Walk along the tree. From a node, go to its left child first, then
+        // to its right child, and then back to its parent. That needs no
+        // stack since each node knows its parent.
+
+        EulerTour result;
+        if (n == 0) return result;
+
+        result.E.reserve(2 * n - 1);
+        result.L.reserve(2 * n - 1);
+        result.R.resize(n);
+
+        size_t uId = root;
+        size_t from = NullNode;
+        size_t level = 1;
+
+        for (;;)
+        {
+            result.R[uId] = result.E.size();
+            result.E.push_back(uId);
+            result.L.push_back(level);
+
+            size_t next = NullNode;
+
+            if (from == par[uId])
+            {
+                // Coming from parent.
+                next = (left[uId] != NullNode) ? left[uId] : right[uId];
+            }
+            else if (from == left[uId])
+            {
+                // Coming from left child.
+                next = right[uId];
+            }
+
+            if (next != NullNode)
+            {
+                // Go down.
+                from = uId;
+                uId = next;
+                level++;
+            }
+            else
+            {
+                // Go up.
+                if (par[uId] == NullNode) break;
+
+                from = uId;
+                uId = par[uId];
+                level--;
+            }
         }
 
-        return Tree(par);
+        return result;
     }
 };
 
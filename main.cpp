@@ -7,15 +7,28 @@
 
 #include <iomanip>
 #include <iostream>
+#include <thread>
 
+#include "blockSparseTableRmq.hpp"
+#include "compactLca.hpp"
+#include "dfsLca.hpp"
 #include "lcaRmq.hpp"
 #include "naiveRmq.hpp"
 #include "noPreRmq.hpp"
+#include "offlineLca.hpp"
+#include "offlineRmq.hpp"
 #include "rmqTest.h"
 #include "segTreeRmq.hpp"
 #include "segTreeCacheRmq.hpp"
+#include "segTreeImplicitRmq.hpp"
+#include "segTreeVebRmq.hpp"
+#include "segTreeLazyRmq.hpp"
+#include "segTreeWideRmq.hpp"
 #include "sparseTableRmq.hpp"
+#include "sqrtTreeRmq.hpp"
+#include "succinctRmq.hpp"
 #include "plusMinusRmq.hpp"
+#include "plusMinusWordRmq.hpp"
 
 
 using namespace std;
@@ -71,12 +84,28 @@ void printTime(int64_t time, ostream& out)
     out << flush;
 }
 
+// Prints the given memory (in bytes) per element into the given stream.
+void printMemory(size_t bytes, size_t elements, ostream& out)
+{
+    out << fixed << setprecision(1) << setw(5);
+    out << double(bytes) / double(elements) << " B/element";
+    out << defaultfloat << flush;
+}
+
 int main()
 {
     const size_t   dataSize = 20000;
     const size_t   queries  = 1000000;
     const unsigned seed     = 19082017;
 
+    // Size of the data when comparing pre-processing with multiple threads.
+    const size_t   buildSize = 1 << 22;
+    const size_t   maxThreads = thread::hardware_concurrency();
+
+    // Largest size of the data when comparing how segment trees scale. Raise
+    // it to 1 << 24 to go far beyond the cache; that needs several GB.
+    const size_t   largeSize = 1 << 20;
+
     cout << "   Size: " << dataSize << endl;
     cout << "Queries: " << queries << endl;
 
@@ -90,6 +119,7 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first, cout);
         cout << "\nQ: "; printTime(timePair.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RMQ<int>>(dataSize, queries, seed), cout);
         cout << endl;
 
         refTime = timePair;
@@ -102,6 +132,19 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+
+        // Verify the vectorized scans of all supported types. The scalar
+        // reference scans every range; hence, use fewer queries.
+        const size_t vQueries = queries / 100;
+        bool correct =
+            RMQTest::verifyNoPre<int8_t>(dataSize, vQueries, seed) &&
+            RMQTest::verifyNoPre<int16_t>(dataSize, vQueries, seed) &&
+            RMQTest::verifyNoPre<int32_t>(dataSize, vQueries, seed) &&
+            RMQTest::verifyNoPre<int64_t>(dataSize, vQueries, seed) &&
+            RMQTest::verifyNoPre<float>(dataSize, vQueries, seed) &&
+            RMQTest::verifyNoPre<double>(dataSize, vQueries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
         cout << endl;
     }
 
@@ -133,6 +176,8 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<SegTreeRMQ<int>>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<SegTreeRMQ<int>>(dataSize, queries, seed), cout);
 
         // Verify correctness.
         bool correct =
@@ -144,6 +189,10 @@ int main()
             (dataSize, queries, seed);
         cout << "\nC: " << (correct ? "Yes" : "No");
 
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<SegTreeRMQ<int>>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
         cout << endl;
     }
 
@@ -154,6 +203,8 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<SegTreeCacheRMQ<int>>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<SegTreeCacheRMQ<int>>(dataSize, queries, seed), cout);
 
         // Verify correctness.
         bool correct =
@@ -165,6 +216,203 @@ int main()
             (dataSize, queries, seed);
         cout << "\nC: " << (correct ? "Yes" : "No");
 
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<SegTreeCacheRMQ<int>>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree Cache (Parallel Pre-Processing) ***";
+    {
+        cout << "\nSize: " << buildSize;
+
+        for (size_t threads = 1; threads <= max<size_t>(maxThreads, 1); threads <<= 1)
+        {
+            size_t time =
+                RMQTest::getParallelRuntime<SegTreeCacheRMQ<int>>
+                (
+                    buildSize,
+                    seed,
+                    threads
+                );
+
+            cout << "\nP (" << setw(2) << threads << " threads): ";
+            printTime(time, cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree Cache (Compact) ***";
+    {
+        typedef SegTreeVebRMQ<int> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<RmqType>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness. Sizes just above and below a power of two are
+        // the worst and best cases for the pruning.
+        bool correct =
+            RMQTest::verifyAlgorithms<SegTreeRMQ<int>, RmqType>(dataSize, queries, seed) &&
+            RMQTest::verifyAlgorithms<SegTreeRMQ<int>, RmqType>((1 << 14) + 1, queries, seed) &&
+            RMQTest::verifyAlgorithms<SegTreeRMQ<int>, RmqType>((1 << 14) - 1, queries, seed) &&
+            RMQTest::verifyAlgorithms<SegTreeRMQ<int>, RmqType>(2, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare the memory with the original layout if the size is just
+        // above a power of two.
+        const size_t badSize = (1 << 14) + 1;
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << "\nM (n = " << badSize << "): ";
+        printMemory(RMQTest::getMemory<RmqType>(badSize, seed).second, badSize, cout);
+
+        cout << "\nM (n = " << badSize << ", original): ";
+        printMemory(RMQTest::getMemory<SegTreeCacheRMQ<int>>(badSize, seed).second, badSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree (Implicit) ***";
+    {
+        typedef SegTreeImplicitRMQ<int, uint32_t> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SegTreeRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree (Wide) ***";
+    {
+        typedef SegTreeWideRMQ<int, 16, uint32_t> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<RmqType>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SegTreeRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed) &&
+            RMQTest::verifyAlgorithms
+            <
+                SegTreeRMQ<int>,
+                SegTreeWideRMQ<int, 3>
+            >
+            (dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        // Scans of one block (B) and of two blocks, scalar and vectorized.
+        for (size_t length : { size_t(16), size_t(32) })
+        {
+            timePair = RMQTest::getScanRuntime(dataSize, length, queries, seed);
+            cout << "\nScan (" << setw(2) << length << "): Scalar: ";
+            printTime(timePair.first, cout);
+            cout << "  SIMD: "; printTime(timePair.second, cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Trees (Updates) ***";
+    {
+        // Each round changes some elements and then runs some queries.
+        const size_t rounds  = 1000;
+        const size_t changes = 100;
+        const size_t rQueries = queries / rounds;
+
+        cout << "\nRounds: " << rounds << " x (" << changes << " changes + " << rQueries << " queries)";
+
+        cout << "\nSegment Tree (update):        ";
+        printTime(RMQTest::getUpdateRuntime<SegTreeRMQ<int>>(dataSize, rounds, changes, rQueries, seed), cout);
+
+        cout << "\nSegment Tree (rebuild):       ";
+        printTime(RMQTest::getRebuildRuntime<SegTreeRMQ<int>>(dataSize, rounds, changes, rQueries, seed), cout);
+
+        cout << "\nSegment Tree Cache (update):  ";
+        printTime(RMQTest::getUpdateRuntime<SegTreeCacheRMQ<int>>(dataSize, rounds, changes, rQueries, seed), cout);
+
+        cout << "\nSegment Tree Cache (rebuild): ";
+        printTime(RMQTest::getRebuildRuntime<SegTreeCacheRMQ<int>>(dataSize, rounds, changes, rQueries, seed), cout);
+
+        cout << "\nSparse Table (rebuild):       ";
+        printTime(RMQTest::getRebuildRuntime<SparseTableRMQ<int>>(dataSize, rounds, changes, rQueries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyUpdates<SegTreeRMQ<int>>(dataSize, 10, changes, rQueries, seed) &&
+            RMQTest::verifyUpdates<SegTreeCacheRMQ<int>>(dataSize, 10, changes, rQueries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree (Range Additions) ***";
+    {
+        typedef SegTreeLazyRMQ<int> RmqType;
+
+        // Each round adds deltas to some ranges and then runs some queries.
+        const size_t rounds = 100;
+        const size_t rQueries = queries / rounds;
+
+        for (size_t adds : { size_t(10), size_t(10000) })
+        {
+            cout << "\nRounds: " << rounds << " x (" << adds << " additions + " << rQueries << " queries)";
+
+            cout << "\nSingle:  ";
+            printTime(RMQTest::getRangeAddRuntime<RmqType>(dataSize, rounds, adds, rQueries, seed, false), cout);
+
+            cout << "\nBatched: ";
+            printTime(RMQTest::getRangeAddRuntime<RmqType>(dataSize, rounds, adds, rQueries, seed, true), cout);
+        }
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms<RmqType, SegTreeRMQ<int>>(dataSize, queries, seed) &&
+            RMQTest::verifyRangeAdds<RmqType>(dataSize, 10, 100, rQueries, seed) &&
+            RMQTest::verifyRangeAdds<RmqType>(dataSize, 10, 5000, rQueries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
         cout << endl;
     }
 
@@ -175,6 +423,8 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<SparseTableRMQ<int>>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<SparseTableRMQ<int>>(dataSize, queries, seed), cout);
 
         // Verify correctness.
         bool correct =
@@ -186,6 +436,352 @@ int main()
             (dataSize, queries, seed);
         cout << "\nC: " << (correct ? "Yes" : "No");
 
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<SparseTableRMQ<int>>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Sparse Table (32-bit Indices) ***";
+    {
+        typedef SparseTableRMQ<int, uint32_t> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Sparse Table (32-bit Indices, Values) ***";
+    {
+        typedef SparseTableRMQ<int, uint32_t, true> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(dataSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, dataSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Sparse Table (Parallel Pre-Processing) ***";
+    {
+        cout << "\nSize: " << buildSize;
+
+        for (size_t threads = 1; threads <= max<size_t>(maxThreads, 1); threads <<= 1)
+        {
+            size_t time =
+                RMQTest::getParallelRuntime<SparseTableRMQ<int, uint32_t>>
+                (
+                    buildSize,
+                    seed,
+                    threads
+                );
+
+            cout << "\nP (" << setw(2) << threads << " threads): ";
+            printTime(time, cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Trees (Large Data) ***";
+    {
+        // Compare how the trees scale once they no longer fit into the cache.
+        // Sizes are limited by largeSize; the sparse table and the binary
+        // trees need 40 to 110 bytes per element.
+        for (size_t size = 1 << 16; size <= largeSize; size <<= 4)
+        {
+            cout << "\nSize: " << size;
+
+            cout << "\nSegment Tree:       ";
+            printTime(RMQTest::getBatchRuntime<SegTreeRMQ<int>>(size, queries, seed), cout);
+
+            cout << "\nSegment Tree Cache: ";
+            printTime(RMQTest::getBatchRuntime<SegTreeCacheRMQ<int>>(size, queries, seed), cout);
+
+            cout << "\nSegment Tree vEB:   ";
+            printTime(RMQTest::getBatchRuntime<SegTreeVebRMQ<int>>(size, queries, seed), cout);
+
+            cout << "\nSegment Tree Wide:  ";
+            printTime(RMQTest::getBatchRuntime<SegTreeWideRMQ<int, 16, uint32_t>>(size, queries, seed), cout);
+
+            cout << "\nSparse Table:       ";
+            printTime(RMQTest::getBatchRuntime<SparseTableRMQ<int, uint32_t>>(size, queries, seed), cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Trees (Interleaved Queries) ***";
+    {
+        // Batches (B) prefetch the data of later queries. Interleaved batches
+        // (I) run 16 queries at once and prefetch each node before visiting it.
+        bool correct =
+            RMQTest::verifyInterleaved<SegTreeRMQ<int>>(dataSize, queries, seed) &&
+            RMQTest::verifyInterleaved<SegTreeCacheRMQ<int>>(dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        for (size_t size : { size_t(dataSize), largeSize })
+        {
+            cout << "\nSize: " << size;
+
+            cout << "\nSegment Tree:       B: ";
+            printTime(RMQTest::getBatchRuntime<SegTreeRMQ<int>>(size, queries, seed), cout);
+            cout << "  I: ";
+            printTime(RMQTest::getInterleavedRuntime<SegTreeRMQ<int>>(size, queries, seed), cout);
+
+            cout << "\nSegment Tree Cache: B: ";
+            printTime(RMQTest::getBatchRuntime<SegTreeCacheRMQ<int>>(size, queries, seed), cout);
+            cout << "  I: ";
+            printTime(RMQTest::getInterleavedRuntime<SegTreeCacheRMQ<int>>(size, queries, seed), cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Query Scheduling ***";
+    {
+        // Runs batches in random order (B), sorted by blocks of i (O), and
+        // along a Hilbert curve (H). Sorting is included in O and H.
+        bool correct =
+            RMQTest::verifyScheduled<SparseTableRMQ<int>>(dataSize, queries, seed, QueryOrder::Block) &&
+            RMQTest::verifyScheduled<SparseTableRMQ<int>>(dataSize, queries, seed, QueryOrder::Hilbert) &&
+            RMQTest::verifyScheduled<SegTreeCacheRMQ<int>>(dataSize, queries, seed, QueryOrder::Hilbert);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        for (size_t size : { size_t(dataSize), size_t(1) << 20, size_t(buildSize) })
+        {
+            cout << "\nSize: " << size;
+
+            typedef SparseTableRMQ<int, uint32_t> TableType;
+            cout << "\nSparse Table:       B: ";
+            printTime(RMQTest::getBatchRuntime<TableType>(size, queries, seed), cout);
+            cout << "  O: ";
+            printTime(RMQTest::getScheduledRuntime<TableType>(size, queries, seed, QueryOrder::Block), cout);
+            cout << "  H: ";
+            printTime(RMQTest::getScheduledRuntime<TableType>(size, queries, seed, QueryOrder::Hilbert), cout);
+
+            cout << "\nSegment Tree Cache: B: ";
+            printTime(RMQTest::getBatchRuntime<SegTreeCacheRMQ<int>>(size, queries, seed), cout);
+            cout << "  O: ";
+            printTime(RMQTest::getScheduledRuntime<SegTreeCacheRMQ<int>>(size, queries, seed, QueryOrder::Block), cout);
+            cout << "  H: ";
+            printTime(RMQTest::getScheduledRuntime<SegTreeCacheRMQ<int>>(size, queries, seed, QueryOrder::Hilbert), cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Succinct ***";
+    {
+        typedef SuccinctRMQ<int> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<RmqType>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed) &&
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (buildSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with the sparse table for large data.
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getBatchRuntime<RmqType>(buildSize, queries, seed), cout);
+        cout << "\nB (n = " << buildSize << ", Sparse Table): ";
+        printTime(RMQTest::getBatchRuntime<SparseTableRMQ<int, uint32_t>>(buildSize, queries, seed), cout);
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<RmqType>(buildSize, seed);
+        cout << "\nM: "; printMemory(memPair.second, buildSize, cout);
+        cout << " (" << fixed << setprecision(2) << 8.0 * memPair.second / buildSize << defaultfloat << " bits/element)";
+        cout << "\nM (Sparse Table): "; printMemory(RMQTest::getMemory<SparseTableRMQ<int, uint32_t>>(buildSize, seed).second, buildSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Sparse Table (Blocks) ***";
+    {
+        typedef BlockSparseTableRMQ<int> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<RmqType>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness. Also use a size that is not a multiple of the
+        // block size.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed) &&
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (buildSize + 37, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with the sparse table for large data.
+        typedef SparseTableRMQ<int, uint32_t> TableType;
+
+        cout << "\nP (n = " << buildSize << "): ";
+        printTime(RMQTest::getRuntime<RmqType>(buildSize, 1, seed).first, cout);
+        cout << "\nP (n = " << buildSize << ", Sparse Table): ";
+        printTime(RMQTest::getRuntime<TableType>(buildSize, 1, seed).first, cout);
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getBatchRuntime<RmqType>(buildSize, queries, seed), cout);
+        cout << "\nB (n = " << buildSize << ", Sparse Table): ";
+        printTime(RMQTest::getBatchRuntime<TableType>(buildSize, queries, seed), cout);
+
+        // Scans within one block (16 ints), scalar and vectorized.
+        timePair = RMQTest::getScanRuntime(dataSize, 16, queries, seed);
+        cout << "\nScan (16): Scalar: "; printTime(timePair.first, cout);
+        cout << "  SIMD: "; printTime(timePair.second, cout);
+
+        cout << "\nM: "; printMemory(RMQTest::getMemory<RmqType>(buildSize, seed).second, buildSize, cout);
+        cout << "\nM (Sparse Table): "; printMemory(RMQTest::getMemory<TableType>(buildSize, seed).second, buildSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Sqrt Tree ***";
+    {
+        typedef SqrtTreeRMQ<int> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<RmqType>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (dataSize, queries, seed) &&
+            RMQTest::verifyAlgorithms
+            <
+                SparseTableRMQ<int>,
+                RmqType
+            >
+            (buildSize + 37, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with the sparse table and the wide segment tree. Sizes are
+        // limited by the memory of the test machine.
+        for (size_t size : { size_t(100000), size_t(1000000), size_t(10000000) })
+        {
+            cout << "\nSize: " << size;
+
+            cout << "\nSqrt Tree:         P: ";
+            printTime(RMQTest::getRuntime<RmqType>(size, 1, seed).first, cout);
+            cout << "  B: "; printTime(RMQTest::getBatchRuntime<RmqType>(size, queries, seed), cout);
+            cout << "  M: "; printMemory(RMQTest::getMemory<RmqType>(size, seed).second, size, cout);
+
+            typedef SparseTableRMQ<int, uint32_t> TableType;
+            cout << "\nSparse Table:      P: ";
+            printTime(RMQTest::getRuntime<TableType>(size, 1, seed).first, cout);
+            cout << "  B: "; printTime(RMQTest::getBatchRuntime<TableType>(size, queries, seed), cout);
+            cout << "  M: "; printMemory(RMQTest::getMemory<TableType>(size, seed).second, size, cout);
+
+            typedef SegTreeWideRMQ<int, 16, uint32_t> WideType;
+            cout << "\nSegment Tree Wide: P: ";
+            printTime(RMQTest::getRuntime<WideType>(size, 1, seed).first, cout);
+            cout << "  B: "; printTime(RMQTest::getBatchRuntime<WideType>(size, queries, seed), cout);
+            cout << "  M: "; printMemory(RMQTest::getMemory<WideType>(size, seed).second, size, cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Offline ***";
+    {
+        typedef OfflineRMQ<int> RmqType;
+        typedef SparseTableRMQ<int, uint32_t> TableType;
+
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<RmqType>(dataSize, queries, seed), cout);
+
+        // Verify correctness.
+        bool correct =
+            RMQTest::verifyBatch<SparseTableRMQ<int>, RmqType>(dataSize, queries, seed) &&
+            RMQTest::verifyBatch<SparseTableRMQ<int>, RmqType>(buildSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with pre-processing and batched queries of the sparse table.
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getBatchRuntime<RmqType>(buildSize, queries, seed), cout);
+        cout << "\nP + B (n = " << buildSize << ", Sparse Table): ";
+        printTime
+        (
+            RMQTest::getRuntime<TableType>(buildSize, 1, seed).first +
+            RMQTest::getBatchRuntime<TableType>(buildSize, queries, seed),
+            cout
+        );
+
         cout << endl;
     }
 
@@ -206,10 +802,45 @@ int main()
             (dataSize, queries, seed);
         cout << "\nC: " << (correct ? "Yes" : "No");
 
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<PlusMinusRMQ<int>>(buildSize, seed);
+        cout << "\nM (peak): "; printMemory(memPair.first, buildSize, cout);
+        cout << "\nM: "; printMemory(memPair.second, buildSize, cout);
+
         cout << endl;
     }
 
 
+    cout << "\n*** Plus Minus 1 (Word Blocks) ***";
+    {
+        typedef PlusMinusWordRMQ<int> RmqType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getPlusMinusRuntime<RmqType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+
+        // Verify correctness. Also use a size that is not a multiple of the
+        // block size.
+        bool correct =
+            RMQTest::verifyPlusMinus<RmqType>(dataSize, queries, seed) &&
+            RMQTest::verifyPlusMinus<RmqType>(dataSize + 37, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare memory with (log n) / 2 blocks. The memory does not depend
+        // on the data satisfying the +-1 property.
+        cout << "\nQ (n = " << buildSize << "): ";
+        printTime(RMQTest::getPlusMinusRuntime<RmqType>(buildSize, queries, seed).second, cout);
+        cout << "\nQ (n = " << buildSize << ", original): ";
+        printTime(RMQTest::getPlusMinusRuntime<PlusMinusRMQ<int>>(buildSize, queries, seed).second, cout);
+
+        cout << "\nM: "; printMemory(RMQTest::getMemory<RmqType>(buildSize, seed).second, buildSize, cout);
+        cout << "\nM (original): "; printMemory(RMQTest::getMemory<PlusMinusRMQ<int>>(buildSize, seed).second, buildSize, cout);
+
+        cout << endl;
+    }
+
     cout << "\n*** RMQ via +-1 LCA ***";
     {
         pair<size_t, size_t> timePair =
@@ -217,6 +848,8 @@ int main()
 
         cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << "\nS: "; printTime(RMQTest::getStaticRuntime<LcaRMQ<int>>(dataSize, queries, seed).second - refTime.second, cout);
+        cout << "\nB: "; printTime(RMQTest::getBatchRuntime<LcaRMQ<int>>(dataSize, queries, seed), cout);
 
         // Verify correctness.
         bool correct =
@@ -228,6 +861,14 @@ int main()
             (dataSize, queries, seed);
         cout << "\nC: " << (correct ? "Yes" : "No");
 
+        cout << "\nP (n = " << buildSize << "): ";
+        printTime(RMQTest::getRuntime<LcaRMQ<int>>(buildSize, 1, seed).first, cout);
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getMemory<LcaRMQ<int>>(buildSize, seed);
+        cout << "\nM (peak): "; printMemory(memPair.first, buildSize, cout);
+        cout << "\nM: "; printMemory(memPair.second, buildSize, cout);
+
         cout << endl;
     }
 
@@ -289,4 +930,202 @@ int main()
         cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
         cout << endl;
     }
+
+    cout << "\n*** Plus Minus 1 (Word Blocks) ***";
+    {
+        pair<size_t, size_t> timePair =
+            RMQTest::getAncestorRuntime<PlusMinusWordRMQ<size_t>>
+            (
+                dataSize,
+                queries,
+                seed
+            );
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+        cout << endl;
+    }
+
+    cout << "\n*** Sparse Table (DFS Order) ***";
+    {
+        typedef DfsLCA<SparseTableRMQ<size_t>> LcaType;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getLcaRuntime<LcaType>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+
+        bool correct =
+            RMQTest::verifyLca<LCA<SparseTableRMQ<size_t>>, LcaType>(dataSize, queries, seed) &&
+            RMQTest::verifyLcaBatch<LCA<SparseTableRMQ<size_t>>, LcaType>(dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with the Euler tour on a larger tree.
+        const size_t treeSize = buildSize >> 2;
+
+        auto compare = [&](const char* name, pair<size_t, size_t> times, size_t batch, pair<size_t, size_t> mem)
+        {
+            cout << "\n" << name << " (n = " << treeSize << "):";
+            cout << "\n  P: "; printTime(times.first, cout);
+            cout << "\n  Q: "; printTime(times.second, cout);
+            cout << "\n  B: "; printTime(batch, cout);
+            cout << "\n  M (peak): "; printMemory(mem.first, treeSize, cout);
+            cout << "\n  M: "; printMemory(mem.second, treeSize, cout);
+        };
+
+        compare
+        (
+            "DFS order",
+            RMQTest::getLcaRuntime<LcaType>(treeSize, queries, seed),
+            RMQTest::getLcaBatchRuntime<LcaType>(treeSize, queries, seed).second,
+            RMQTest::getLcaMemory<LcaType>(treeSize, seed)
+        );
+        compare
+        (
+            "Euler tour",
+            RMQTest::getLcaRuntime<LCA<SparseTableRMQ<size_t>>>(treeSize, queries, seed),
+            RMQTest::getLcaBatchRuntime<LCA<SparseTableRMQ<size_t>>>(treeSize, queries, seed).second,
+            RMQTest::getLcaMemory<LCA<SparseTableRMQ<size_t>>>(treeSize, seed)
+        );
+        compare
+        (
+            "Euler tour, +-1",
+            RMQTest::getLcaRuntime<LCA<PlusMinusRMQ<size_t>>>(treeSize, queries, seed),
+            RMQTest::getLcaBatchRuntime<LCA<PlusMinusRMQ<size_t>>>(treeSize, queries, seed).second,
+            RMQTest::getLcaMemory<LCA<PlusMinusRMQ<size_t>>>(treeSize, seed)
+        );
+
+        cout << endl;
+    }
+
+    cout << "\n*** Plus Minus 1 (Compact Euler Tour) ***";
+    {
+        typedef LCA<PlusMinusRMQ<size_t>> Original;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getLcaRuntime<CompactLCA>(dataSize, queries, seed);
+
+        cout << "\nP: "; printTime(timePair.first - refTime.first, cout);
+        cout << "\nQ: "; printTime(timePair.second - refTime.second, cout);
+
+        bool correct =
+            RMQTest::verifyLca<Original, CompactLCA>(dataSize, queries, seed) &&
+            RMQTest::verifyLca<Original, CompactLCA>(dataSize + 37, queries, seed) &&
+            RMQTest::verifyLcaBatch<Original, CompactLCA>(dataSize + 37, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        cout << "\nP (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaRuntime<CompactLCA>(buildSize, 0, seed).first, cout);
+        cout << "\nP (n = " << buildSize << ", original): ";
+        printTime(RMQTest::getLcaRuntime<Original>(buildSize, 0, seed).first, cout);
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaBatchRuntime<CompactLCA>(buildSize, queries, seed).second, cout);
+        cout << "\nB (n = " << buildSize << ", original): ";
+        printTime(RMQTest::getLcaBatchRuntime<Original>(buildSize, queries, seed).second, cout);
+
+        pair<size_t, size_t> memPair =
+            RMQTest::getLcaMemory<CompactLCA>(buildSize, seed);
+        cout << "\nM (peak): "; printMemory(memPair.first, buildSize, cout);
+        cout << "\nM: "; printMemory(memPair.second, buildSize, cout);
+
+        memPair = RMQTest::getLcaMemory<Original>(buildSize, seed);
+        cout << "\nM (peak, original): "; printMemory(memPair.first, buildSize, cout);
+        cout << "\nM (original): "; printMemory(memPair.second, buildSize, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Plus Minus 1 (Parallel Euler Tour) ***";
+    {
+        // The threaded tour is only used for large trees; hence, verify it
+        // with buildSize.
+        bool correct = RMQTest::verifyEulerTour(buildSize, seed, max<size_t>(maxThreads, 2));
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // The same tours with 32-bit node IDs.
+        correct = RMQTest::verifyTree32(buildSize, seed, max<size_t>(maxThreads, 2));
+        cout << "\nC (Tree32): " << (correct ? "Yes" : "No");
+
+        cout << "\nSize: " << buildSize;
+
+        for (size_t threads = 1; threads <= max<size_t>(maxThreads, 1); threads <<= 1)
+        {
+            pair<size_t, size_t> timePair =
+                RMQTest::getAncestorRuntime<PlusMinusRMQ<size_t>>
+                (
+                    buildSize,
+                    0,
+                    seed,
+                    threads
+                );
+
+            cout << "\nP (" << setw(2) << threads << " threads): ";
+            printTime(timePair.first, cout);
+        }
+
+        cout << endl;
+    }
+
+    cout << "\n*** Segment Tree Cache (Interleaved Queries) ***";
+    {
+        typedef LCA<SegTreeCacheRMQ<size_t>> LcaType;
+
+        bool correct =
+            RMQTest::verifyLcaBatch<LCA<SparseTableRMQ<size_t>>, LcaType>(dataSize, queries, seed) &&
+            RMQTest::verifyLcaInterleaved<LCA<SparseTableRMQ<size_t>>, LcaType>(dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaBatchRuntime<LcaType>(buildSize, queries, seed).second, cout);
+        cout << "\nI (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaInterleavedRuntime<LcaType>(buildSize, queries, seed).second, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Offline (Tarjan) ***";
+    {
+        typedef LCA<PlusMinusRMQ<size_t>> Online;
+
+        pair<size_t, size_t> timePair =
+            RMQTest::getLcaBatchRuntime<OfflineLCA>(dataSize, queries, seed);
+        cout << "\nB: "; printTime(timePair.second, cout);
+
+        bool correct =
+            RMQTest::verifyLcaBatch<Online, OfflineLCA>(dataSize, queries, seed);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        // Compare with pre-processing and a batch of the +-1 LCA.
+        timePair = RMQTest::getLcaBatchRuntime<OfflineLCA>(buildSize, queries, seed);
+        cout << "\nB (n = " << buildSize << "): "; printTime(timePair.second, cout);
+
+        timePair = RMQTest::getLcaBatchRuntime<Online>(buildSize, queries, seed);
+        cout << "\nP + B (n = " << buildSize << ", Plus Minus 1): ";
+        printTime(timePair.first + timePair.second, cout);
+
+        cout << endl;
+    }
+
+    cout << "\n*** Query Scheduling (LCA) ***";
+    {
+        // Runs batches of node pairs in random order (B), sorted by blocks of
+        // u (O), and along a Hilbert curve (H). Sorting is included in O and H.
+        typedef LCA<SegTreeCacheRMQ<size_t>> LcaType;
+        typedef LCA<SparseTableRMQ<size_t>> RefType;
+
+        bool correct =
+            RMQTest::verifyLcaScheduled<RefType, LcaType>(dataSize, queries, seed, QueryOrder::Block) &&
+            RMQTest::verifyLcaScheduled<RefType, LcaType>(dataSize, queries, seed, QueryOrder::Hilbert);
+        cout << "\nC: " << (correct ? "Yes" : "No");
+
+        cout << "\nB (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaBatchRuntime<LcaType>(buildSize, queries, seed).second, cout);
+        cout << "\nO (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaScheduledRuntime<LcaType>(buildSize, queries, seed, QueryOrder::Block).second, cout);
+        cout << "\nH (n = " << buildSize << "): ";
+        printTime(RMQTest::getLcaScheduledRuntime<LcaType>(buildSize, queries, seed, QueryOrder::Hilbert).second, cout);
+
+        cout << endl;
+    }
 }
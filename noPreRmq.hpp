@@ -7,6 +7,7 @@
 
 
 #include "rmq.hpp"
+#include "simdArgmin.hpp"
 
 
 template<typename T>
@@ -25,17 +26,11 @@ public:
     // Returns the index of the minimum in that range.
     // Behaviour is undefined if the given range is invalid or pre-processing
     // has not been done.
+    // For primitive numeric types, the range is scanned with vector
+    // instructions if available (see simdArgmin.hpp).
     size_t operator()(size_t i, size_t j) const
     {
-        // First entry is default minimum.
-        size_t minIdx = i;
-
-        for (size_t idx = i + 1; idx <= j; idx++)
-        {
-            minIdx = this->minIndex(minIdx, idx);
-        }
-
-        return minIdx;
+        return i + simdArgmin(&this->data[i], j - i + 1);
     }
 };
 
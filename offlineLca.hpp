@@ -0,0 +1,105 @@
+// Defines an algorithm to find the lowest common ancestors of a whole batch of
+// node pairs at once (Tarjan's offline algorithm). It runs a DFS over the tree.
+// Each node that has been left is in the set (see DisjointSets) of its closest
+// ancestor on the current DFS path. When the DFS leaves a node u, the LCA of u
+// and each already visited node v is the representative of v's set.
+// Runtime: O(1) | O(n + q * alpha(n)) per batch of q pairs
+
+
+#ifndef __OfflineLCA_HPP__
+#define __OfflineLCA_HPP__
+
+#include "disjointSets.hpp"
+#include "tree.h"
+
+
+class OfflineLCA
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    OfflineLCA(const Tree& tree) : tree(&tree) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    // Does nothing; all work is done by batch().
+    void processData() { /* Nothing. */ }
+
+    // Determines the lowest common ancestor for each of the given node pairs
+    // and writes it into results[], i.e., results[q] is the LCA of pairs[q].
+    void batch(const std::pair<size_t, size_t>* pairs, size_t count, size_t* results) const
+    {
+        const size_t n = tree->size();
+
+        // Assign each pair to both of its nodes. The pairs of node u are
+        // byNode[start[u]], ..., byNode[start[u + 1] - 1].
+        vector<size_t> start(n + 1, 0);
+        for (size_t q = 0; q < count; q++)
+        {
+            start[pairs[q].first + 1]++;
+            start[pairs[q].second + 1]++;
+        }
+        for (size_t u = 0; u < n; u++) start[u + 1] += start[u];
+
+        vector<size_t> byNode(2 * count);
+        {
+            vector<size_t> next(start.begin(), start.end() - 1);
+            for (size_t q = 0; q < count; q++)
+            {
+                byNode[next[pairs[q].first]++] = q;
+                byNode[next[pairs[q].second]++] = q;
+            }
+        }
+
+
+        // Run DFS. A node is its own representative until it is left; then it
+        // is linked to its parent, which is still on the path.
+        DisjointSets sets(n);
+        vector<bool> visited(n, false);
+
+        // The nodes on the current path and their next child.
+        vector<std::pair<size_t, size_t>> stack;
+        stack.emplace_back(tree->getRoot(), 0);
+
+        while (stack.size() > 0)
+        {
+            size_t uId = stack.back().first;
+            size_t& cIdx = stack.back().second;
+
+            Span<size_t> children = (*tree)[uId];
+
+            if (cIdx < children.size())
+            {
+                // Push
+                stack.emplace_back(children[cIdx++], 0);
+                continue;
+            }
+
+            // All children are done; answer the pairs of u.
+            visited[uId] = true;
+
+            for (size_t p = start[uId]; p < start[uId + 1]; p++)
+            {
+                size_t q = byNode[p];
+                size_t vId = pairs[q].first == uId ? pairs[q].second : pairs[q].first;
+
+                if (visited[vId]) results[q] = sets.find(vId);
+            }
+
+            // Backtrack.
+            stack.pop_back();
+            if (stack.size() > 0) sets.link(uId, stack.back().first);
+        }
+    }
+
+private:
+
+    const Tree* tree;
+
+};
+
+#endif
@@ -0,0 +1,86 @@
+// Represents a RMQ that answers a whole batch of queries at once instead of
+// pre-processing the data. It sorts the queries by their right end and scans
+// the data from left to right. A stack keeps the minima of all suffixes of
+// the scanned part, and each scanned element is in the set (see
+// DisjointSets) of the closest stack entry at or right of it; that entry is
+// the minimum of the range from the element to the current position.
+// Single queries scan their range.
+// Runtime: O(1) | O(n + q * alpha(n)) per batch of q queries
+
+#ifndef __OfflineRmq_HPP__
+#define __OfflineRmq_HPP__
+
+
+#include "disjointSets.hpp"
+#include "rmq.hpp"
+
+
+template<typename T>
+class OfflineRMQ : public RMQ<T>
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    OfflineRMQ(const std::vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
+
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid.
+    size_t operator()(size_t i, size_t j) const
+    {
+        size_t minIdx = j;
+        for (size_t k = i; k < j; k++) minIdx = this->minIndex(k, minIdx);
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        const vector<T>& data = this->data;
+        const size_t n = data.size();
+
+        // Sort queries by right end (counting sort). The queries ending at j
+        // are byEnd[start[j]], ..., byEnd[start[j + 1] - 1].
+        vector<size_t> start(n + 1, 0);
+        for (size_t q = 0; q < count; q++) start[ranges[q].second + 1]++;
+        for (size_t j = 0; j < n; j++) start[j + 1] += start[j];
+
+        vector<size_t> byEnd(count);
+        {
+            vector<size_t> next(start.begin(), start.end() - 1);
+            for (size_t q = 0; q < count; q++) byEnd[next[ranges[q].second]++] = q;
+        }
+
+        // Scan data.
+        DisjointSets sets(n);
+        vector<size_t> stack;
+
+        for (size_t j = 0; j < n; j++)
+        {
+            // Elements that are not smaller than data[j] are no suffix minima
+            // anymore; j is the minimum of their ranges from now on.
+            while (stack.size() > 0 && !(data[stack.back()] < data[j]))
+            {
+                sets.link(stack.back(), j);
+                stack.pop_back();
+            }
+
+            stack.push_back(j);
+
+            for (size_t p = start[j]; p < start[j + 1]; p++)
+            {
+                size_t q = byEnd[p];
+                results[q] = sets.find(ranges[q].first);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,67 @@
+// Implements helper functions to run loops on multiple threads.
+
+#ifndef __Parallel_HPP__
+#define __Parallel_HPP__
+
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+// Returns the number of threads algorithms use by default.
+inline size_t defaultThreadCount()
+{
+    size_t count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+
+// Splits [begin, end) into chunks of the given size and calls f(sta, end) for
+// each chunk [sta, end). Uses up to the given number of threads (including the
+// calling one). Threads take the next unprocessed chunk whenever they finish
+// one. Returns once all chunks are processed.
+template<typename F>
+void parallelFor(size_t begin, size_t end, size_t threads, size_t chunkSize, F f)
+{
+    if (begin >= end) return;
+
+    const size_t chunks = (end - begin - 1) / chunkSize + 1;
+    threads = std::min(threads, chunks);
+
+    if (threads <= 1)
+    {
+        f(begin, end);
+        return;
+    }
+
+
+    std::atomic<size_t> next(0);
+
+    auto work = [&]()
+    {
+        for (size_t c = next++; c < chunks; c = next++)
+        {
+            size_t sta = begin + c * chunkSize;
+            f(sta, std::min(end, sta + chunkSize));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+
+    for (size_t t = 1; t < threads; t++)
+    {
+        pool.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread& thread : pool)
+    {
+        thread.join();
+    }
+}
+
+#endif
@@ -32,25 +32,14 @@ class PlusMinusRMQ : public RMQ<T>
 public:
 
     // Constructor.
-    PlusMinusRMQ(const vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
-
-    // Destructor.
-    ~PlusMinusRMQ()
-    {
-        if (tableRmq != nullptr) delete tableRmq;
-
-        for (SparseTableRMQ<T>*& ptr : classRmq)
-        {
-            if (ptr != nullptr) delete ptr;
-        }
-    }
+    PlusMinusRMQ(const vector<T>& data) : RMQ<T>(data), tableRmq(blockMinVal) { /* Nothing. */ }
 
 
     // Pre-processes the data to allow queries.
     void processData()
     {
-        const vector<T> data = this->data;
-        const size_t    n    = this->data.size();
+        const vector<T>& data = this->data;
+        const size_t     n    = this->data.size();
 
         // Determine block size.
         {
@@ -76,6 +65,9 @@ public:
         // ceil(x / y) = floor((x - 1) / y) + 1
         size_t blockCount = ((n - 1) >> blockDiv) + 1;
         {
+            blockMinVal.clear();
+            blockMinIdx.clear();
+
             blockMinVal.reserve(blockCount);
             blockMinIdx.reserve(blockCount);
 
@@ -104,24 +96,19 @@ public:
             }
 
             // Create RMQ over blocks.
-            tableRmq = new SparseTableRMQ<T>(blockMinVal);
-            tableRmq->processData();
+            tableRmq.processData();
         }
 
 
         // --- Classify blocks. ---
 
-        // Note that we do not need to handle the last block B as special case as
-        // long as we classify it last. If its class is unique, it will be
-        // processed automatically. If it has the same class as a previous block,
-        // we still only run queries on a range fitting to B which is still
-        // equivalent to a query on the earlier block.
-
-        size_t classCount = 1 << (blockSize - 1);
+        // The class of a block has one bit per step between consecutive
+        // elements; the first step is the highest bit. The last block may be
+        // shorter than the others. We treat its missing steps as +1, i.e.,
+        // the missing elements are larger than all before them. That does not
+        // change the results of queries within the existing elements.
 
-        blockCls.resize(blockCount, 0);
-        classRmq.resize(classCount, nullptr);
-        classData.resize(classCount);
+        blockCls.assign(blockCount, 0);
 
         for (size_t b = 0; b < blockCount; b++)
         {
@@ -130,30 +117,54 @@ public:
             size_t bSta = b * blockSize;
             size_t bEnd = std::min(bSta + blockSize, n);
 
-            for (size_t i = bSta + 1; i < bEnd; i++, cls <<= 1)
+            for (size_t i = bSta + 1; i < bEnd; i++)
             {
                 size_t a = data[i - 1];
                 size_t b = data[i];
 
                 // Determine if it is +1 (0) or -1 (1).
-                cls |= (((a ^ b) >> 1) ^ a) & 1;
+                cls = (cls << 1) | ((((a ^ b) >> 1) ^ a) & 1);
+            }
+
+            // Add missing steps of the last block.
+            cls <<= bSta + blockSize - bEnd;
+        }
+
+
+        // --- Compute in-block minima for all classes. ---
+
+        // For each class c and each range [i, j] in a block, the table stores
+        // the position of the minimum at index (c * b + i) * b + j, where b is
+        // the block size. Each entry fits into a byte.
+
+        size_t classCount = size_t(1) << (blockSize - 1);
+        inBlockTable.resize(classCount << (2 * blockDiv));
+
+        vector<int> values(blockSize);
+
+        for (size_t cls = 0; cls < classCount; cls++)
+        {
+            // Create a sequence that belongs to the class.
+            values[0] = 0;
+            for (size_t k = 1; k < blockSize; k++)
+            {
+                bool down = (cls >> (blockSize - 1 - k)) & 1;
+                values[k] = values[k - 1] + (down ? -1 : 1);
             }
 
-            // Undo last shift.
-            cls >>= 1;
+            uint8_t* clsTable = inBlockTable.data() + (cls << (2 * blockDiv));
 
-            // Has that class an RMQ?
-            SparseTableRMQ<T>*& rmqPtr = classRmq[cls];
-            if (rmqPtr == nullptr)
+            for (size_t i = 0; i < blockSize; i++)
             {
-                // Create RMQ for class.
-                classData[cls] = vector<T>
-                (
-                    data.begin() + bSta,
-                    data.begin() + bEnd
-                );
-                rmqPtr = new SparseTableRMQ<T>(classData[cls]);
-                (*rmqPtr).processData();
+                uint8_t* row = clsTable + (i << blockDiv);
+                size_t minPos = i;
+
+                for (size_t j = i; j < blockSize; j++)
+                {
+                    // Same as minIndex(), i.e., prefer later positions.
+                    if (values[j] <= values[minPos]) minPos = j;
+                    row[j] = uint8_t(minPos);
+                }
             }
         }
     }
@@ -191,12 +202,32 @@ public:
 
 
         // Determine the minimum in the blocks between i and j.
-        size_t bIdx = (*tableRmq)(iB + 1, jB - 1);
+        size_t bIdx = staticQuery(tableRmq, iB + 1, jB - 1);
         size_t bMin = blockMinIdx[bIdx];
 
         return this->minIndex(ijMin, bMin);
     }
 
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the classes of the blocks of a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&blockCls[r.first >> blockDiv]);
+                prefetch(&blockCls[r.second >> blockDiv]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = PlusMinusRMQ<T>::operator()(r.first, r.second);
+        }
+    }
+
 
 private:
 
@@ -205,11 +236,9 @@ private:
     // original data.
     size_t inBlockMin(size_t b, size_t i, size_t j) const
     {
-        // Determine class and RMQ.
-        size_t bClass = blockCls[b];
-        SparseTableRMQ<T>& rmq = *(classRmq[bClass]);
+        size_t entry = (((blockCls[b] << blockDiv) | i) << blockDiv) | j;
 
-        return b * blockSize /* starting point of block */ + rmq(i, j);
+        return b * blockSize /* starting point of block */ + inBlockTable[entry];
     }
 
 
@@ -230,17 +259,15 @@ private:
     vector<size_t> blockMinIdx;
 
     // A RMQ to find the minimum block.
-    SparseTableRMQ<T>* tableRmq = nullptr;
+    SparseTableRMQ<T> tableRmq;
 
 
     // States for each block, what class it is.
     vector<size_t> blockCls;
 
-    // Allows to determine the minimum in a single block.
-    vector<SparseTableRMQ<T>*> classRmq;
-
-    // The data for each class. These are copies of the original data.
-    vector<vector<T>> classData;
+    // The position of the minimum for each class and each range in a block.
+    // See processData() for details.
+    vector<uint8_t> inBlockTable;
 
 };
 
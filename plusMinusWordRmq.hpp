@@ -0,0 +1,256 @@
+// Represents a RMQ for sequences that satisfy +_1 property.
+// Unlike PlusMinusRMQ, it splits the data into blocks of 64 elements. The
+// steps of each block are stored as bits of a single word, and queries within
+// a block use bit operations on that word (see bitRmq.hpp). Hence, there are
+// no tables for block classes, and queries do not access the data.
+
+// Runtime: O(n) | O(1)
+
+
+#ifndef __PlusMinusWordRmq_H__
+#define __PlusMinusWordRmq_H__
+
+
+#include <cstdint>
+
+#include "bitRmq.hpp"
+#include "rmq.hpp"
+#include "sparseTableRmq.hpp"
+
+
+template
+<
+    typename T,
+    // Only allow integer types (excluding bool).
+    typename = typename std::enable_if
+    <
+        std::is_integral<T>::value && !std::is_same<T, bool>::value,
+        T
+    >::type
+>
+class PlusMinusWordRMQ : public RMQ<T>
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    PlusMinusWordRMQ(const vector<T>& data) :
+        RMQ<T>(data),
+        n(data.size()),
+        steps(ownSteps),
+        tableRmq(blockMinVal)
+    { /* Nothing. */ }
+
+    // Constructor.
+    // Runs queries on a sequence of the given size that is only given by its
+    // first element and its steps: bit k of steps[k / 64] is set if element k
+    // is one smaller than element k - 1 (see bitRmq.hpp). The steps are used
+    // directly; they are not copied and the sequence is never created.
+    PlusMinusWordRMQ(const vector<uint64_t>& steps, size_t size, T first) :
+        RMQ<T>(noData()),
+        n(size),
+        first(first),
+        steps(steps),
+        tableRmq(blockMinVal)
+    { /* Nothing. */ }
+
+    // Copies would still refer to the steps (if computed from the data) and
+    // the block minima of the original; hence, they are not allowed.
+    PlusMinusWordRMQ(const PlusMinusWordRMQ&) = delete;
+    PlusMinusWordRMQ& operator=(const PlusMinusWordRMQ&) = delete;
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        // ceil(x / y) = floor((x - 1) / y) + 1
+        size_t blockCount = ((n - 1) >> BlockDiv) + 1;
+
+        blockFirst.resize(blockCount);
+        blockMinVal.resize(blockCount);
+        blockMinPos.resize(blockCount);
+
+        if (&steps == &ownSteps) readData(blockCount);
+        else readSteps(blockCount);
+
+        for (size_t b = 0; b < blockCount; b++)
+        {
+            size_t bSta = b * BlockSize;
+            size_t bEnd = std::min(bSta + BlockSize, n);
+
+            size_t pos = bitArgmin(steps[b], bEnd - bSta);
+
+            blockMinPos[b] = uint8_t(pos);
+            blockMinVal[b] = T(blockFirst[b] + bitExcess(steps[b], pos));
+        }
+
+        // Create RMQ over blocks.
+        tableRmq.processData();
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        // Determine block indices.
+        size_t iB = i >> BlockDiv;
+        size_t jB = j >> BlockDiv;
+
+        // Determine indices in block.
+        size_t iIdx = i & BlockMod;
+        size_t jIdx = j & BlockMod;
+
+        if (iB == jB)
+        {
+            // i and j are in the same block.
+            return i + bitArgmin(steps[iB] >> iIdx, jIdx - iIdx + 1);
+        }
+
+
+        // i and j are in different blocks.
+
+        // If the range within a block contains the block's minimum, it is
+        // also the minimum of the range.
+        size_t iMin = iIdx <= blockMinPos[iB] ?
+            i - iIdx + blockMinPos[iB] :
+            i + bitArgmin(steps[iB] >> iIdx, BlockSize - iIdx);
+
+        size_t jMin = jIdx >= blockMinPos[jB] ?
+            j - jIdx + blockMinPos[jB] :
+            j - jIdx + bitArgmin(steps[jB], jIdx + 1);
+
+        T iVal = value(iMin);
+        T jVal = value(jMin);
+
+        // Same as minIndex().
+        size_t ijMin = iVal < jVal ? iMin : jMin;
+        T ijVal = iVal < jVal ? iVal : jVal;
+
+
+        // Are blocks adjacent?
+        if (iB + 1 == jB) return ijMin;
+
+
+        // Determine the minimum in the blocks between i and j.
+        size_t b = staticQuery(tableRmq, iB + 1, jB - 1);
+
+        if (ijVal < blockMinVal[b]) return ijMin;
+        else return (b << BlockDiv) + blockMinPos[b];
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the steps of the blocks of a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&steps[r.first >> BlockDiv]);
+                prefetch(&steps[r.second >> BlockDiv]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = PlusMinusWordRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The size of a block. Its steps fit into one word.
+    static constexpr size_t BlockSize = 64;
+
+    // Helper for easy division and modulo operations.
+    static constexpr size_t BlockDiv = 6;
+    static constexpr size_t BlockMod = BlockSize - 1;
+
+
+    // Returns an empty sequence for RMQ<> if the data is not given.
+    static const vector<T>& noData()
+    {
+        static const vector<T> empty;
+        return empty;
+    }
+
+    // Computes the steps and the first element of each block from the data.
+    void readData(size_t blockCount)
+    {
+        const vector<T>& data = this->data;
+
+        ownSteps.assign(blockCount, 0);
+
+        for (size_t b = 0; b < blockCount; b++)
+        {
+            size_t bSta = b * BlockSize;
+            size_t bEnd = std::min(bSta + BlockSize, n);
+
+            // Bit k is set if the k-th step in the block goes down.
+            for (size_t i = bSta + 1; i < bEnd; i++)
+            {
+                ownSteps[b] |= uint64_t(data[i] < data[i - 1]) << (i - bSta);
+            }
+
+            blockFirst[b] = data[bSta];
+        }
+    }
+
+    // Computes the first element of each block from the given steps. The
+    // step into a block is bit 0 of its word.
+    void readSteps(size_t blockCount)
+    {
+        T val = first;
+
+        for (size_t b = 0; b < blockCount; b++)
+        {
+            if (b > 0) val = T(val + ((steps[b] & 1) ? -1 : 1));
+
+            blockFirst[b] = val;
+            val = T(val + bitExcess(steps[b], BlockMod));
+        }
+    }
+
+    // Determines the value of the element at index i without accessing the
+    // data.
+    T value(size_t i) const
+    {
+        size_t b = i >> BlockDiv;
+        return T(blockFirst[b] + bitExcess(steps[b], i & BlockMod));
+    }
+
+
+    // The size of the sequence.
+    size_t n;
+
+    // The first element if the sequence is given by its steps.
+    T first = T();
+
+    // The steps if they are computed from the data.
+    vector<uint64_t> ownSteps;
+
+    // The steps of each block. See bitRmq.hpp for the encoding.
+    const vector<uint64_t>& steps;
+
+    // The value of the first element of each block.
+    vector<T> blockFirst;
+
+    // The minimum of each block.
+    vector<T> blockMinVal;
+
+    // The position of each block's minimum within the block.
+    vector<uint8_t> blockMinPos;
+
+    // A RMQ to find the minimum block.
+    SparseTableRMQ<T, uint32_t> tableRmq;
+
+};
+
+#endif
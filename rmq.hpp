@@ -4,14 +4,30 @@
 #define __RMQ_HPP__
 
 
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 
+// Hints the CPU to load the given address into the cache.
+inline void prefetch(const void* ptr)
+{
+#ifdef __GNUC__
+    __builtin_prefetch(ptr);
+#else
+    (void)ptr;
+#endif
+}
+
+
 template<typename T>
 class RMQ
 {
 public:
 
+    // The type of the elements in the sequence.
+    typedef T ValueType;
+
     // The sequence to run queries against.
     const std::vector<T>& data;
 
@@ -34,9 +50,37 @@ public:
     // has not been done.
     virtual size_t operator()(size_t, size_t) const { return 0; };
 
+    // Performs a query for each of the given ranges and writes the index of
+    // each minimum into results[], i.e., results[q] is the result for
+    // ranges[q]. Algorithms override this to avoid a virtual call per query
+    // and to overlap the memory accesses of independent queries.
+    // Behaviour is undefined if a range is invalid or pre-processing has not
+    // been done.
+    virtual void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            results[q] = (*this)(ranges[q].first, ranges[q].second);
+        }
+    }
+
+
+    // Performs a query for each of the given ranges like batch(). Algorithms
+    // whose queries are chains of dependent memory accesses override it to
+    // run several queries at once (see interleave.hpp). By default, it calls
+    // batch().
+    virtual void interleavedBatch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        batch(ranges, count, results);
+    }
+
 
 protected:
 
+    // How many queries ahead batches prefetch memory.
+    static constexpr size_t BatchPrefetch = 8;
+
+
     // Determines which of these indices stores the smaller value.
     size_t minIndex(size_t i, size_t j) const
     {
@@ -45,4 +89,21 @@ protected:
     }
 };
 
+
+// Performs a query on the given RMQ algorithm without virtual dispatch.
+// The call is bound to the implementation of R at compile time which allows
+// the compiler to inline it. Hence, R has to be the actual type of the given
+// algorithm and not one of its base classes.
+template<typename R>
+inline size_t staticQuery(const R& rmq, size_t i, size_t j)
+{
+    static_assert
+    (
+        std::is_base_of<RMQ<typename R::ValueType>, R>::value,
+        "R must inherit from RMQ<>."
+    );
+
+    return rmq.R::operator()(i, j);
+}
+
 #endif
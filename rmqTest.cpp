@@ -1,5 +1,19 @@
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
+
+// The usable size of a heap block is needed to count freed bytes.
+#if defined(__GLIBC__)
+    #include <malloc.h>
+    #define RMQ_TRACK_MEMORY
+    #define usableSize malloc_usable_size
+#elif defined(__APPLE__)
+    #include <malloc/malloc.h>
+    #define RMQ_TRACK_MEMORY
+    #define usableSize malloc_size
+#endif
 
 #include "log.hpp"
 #include "rmqTest.h"
@@ -13,6 +27,144 @@ typedef int Num;
 typedef std::pair<size_t, size_t> TimePair;
 
 
+// Receives results of queries in runtime tests.
+volatile size_t RMQTest::sink = 0;
+
+
+// --- Memory Tracking ---
+
+// To measure the memory used by algorithms, we replace the global operators
+// new and delete and count the bytes allocated on the heap. Counting is only
+// done between startTracking() and stopTracking(), so other tests only pay for
+// reading a flag. Without a way to determine the size of a heap block (see
+// usableSize), no memory is counted.
+
+namespace
+{
+    // Whether allocations are counted.
+    atomic<bool> tracking(false);
+
+    // Bytes currently allocated since tracking started. May become negative
+    // if memory allocated before is freed.
+    atomic<int64_t> curBytes(0);
+
+    // Largest number of bytes allocated since tracking started.
+    atomic<int64_t> maxBytes(0);
+}
+
+#ifdef RMQ_TRACK_MEMORY
+
+namespace
+{
+    // Allocates memory and counts it while tracking.
+    void* countedAlloc(size_t size, size_t align)
+    {
+        // aligned_alloc() requires the size to be a multiple of the alignment.
+        void* ptr =
+            align <= alignof(max_align_t) ?
+            malloc(size) :
+            aligned_alloc(align, (size + align - 1) / align * align);
+
+        if (ptr == nullptr) throw bad_alloc();
+
+        if (tracking.load(memory_order_relaxed))
+        {
+            int64_t cur = curBytes += usableSize(ptr);
+            int64_t max = maxBytes;
+            while (cur > max && !maxBytes.compare_exchange_weak(max, cur)) { }
+        }
+
+        return ptr;
+    }
+
+    // Frees memory allocated by countedAlloc() and counts it while tracking.
+    void countedFree(void* ptr)
+    {
+        if (ptr == nullptr) return;
+
+        if (tracking.load(memory_order_relaxed)) curBytes -= usableSize(ptr);
+        free(ptr);
+    }
+}
+
+void* operator new(size_t size) { return countedAlloc(size, 0); }
+void* operator new[](size_t size) { return countedAlloc(size, 0); }
+void* operator new(size_t size, align_val_t al) { return countedAlloc(size, size_t(al)); }
+void* operator new[](size_t size, align_val_t al) { return countedAlloc(size, size_t(al)); }
+
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, align_val_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t, align_val_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t, align_val_t) noexcept { countedFree(ptr); }
+
+#endif
+
+
+// Starts counting the bytes allocated on the heap, beginning at zero.
+void RMQTest::startTracking()
+{
+    curBytes = 0;
+    maxBytes = 0;
+    tracking = true;
+}
+
+// Stops counting the bytes allocated on the heap.
+// Returns the peak and the retained number of bytes since startTracking().
+RMQTest::MemoryPair RMQTest::stopTracking()
+{
+    tracking = false;
+
+    return MemoryPair(max<int64_t>(maxBytes, 0), max<int64_t>(curBytes, 0));
+}
+
+
+// Verifies that the Euler tour of a random tree computed with the given
+// number of threads equals the sequential one (E, L, and R).
+bool RMQTest::verifyEulerTour(size_t treeSize, unsigned seed, size_t threads)
+{
+    Tree tree = generateTree(treeSize, seed);
+
+    EulerTour et1 = tree.eulerTour();
+    EulerTour et2 = tree.eulerTour(threads);
+
+    return et1.E == et2.E && et1.L == et2.L && et1.R == et2.R;
+}
+
+
+// Verifies that a random tree with 32-bit node IDs (Tree32) has the same
+// Euler tours as the same tree with Tree, both sequential and with the given
+// number of threads, and the same compact Euler tour.
+bool RMQTest::verifyTree32(size_t treeSize, unsigned seed, size_t threads)
+{
+    Tree tree = generateTree(treeSize, seed);
+
+    vector<uint32_t> parents(treeSize);
+    for (size_t uId = 0; uId < treeSize; uId++)
+    {
+        parents[uId] = tree(uId) == Tree::NullNode ? Tree32::NullNode : uint32_t(tree(uId));
+    }
+
+    Tree32 tree32(std::move(parents));
+
+    auto equal = [](const EulerTour& et1, const EulerTour& et2)
+    {
+        return et1.E == et2.E && et1.L == et2.L && et1.R == et2.R;
+    };
+
+    CompactEulerTour ce1 = tree.compactEulerTour();
+    CompactEulerTour ce2 = tree32.compactEulerTour();
+
+    return
+        equal(tree.eulerTour(), tree32.eulerTour()) &&
+        equal(tree.eulerTour(threads), tree32.eulerTour(threads)) &&
+        ce1.E == ce2.E && ce1.steps == ce2.steps && ce1.R == ce2.R;
+}
+
+
 // Generates a list of random numbers with the given size.
 vector<Num> RMQTest::generateData(size_t size, unsigned seed)
 {
@@ -84,24 +236,98 @@ Tree RMQTest::generateTree(size_t size, unsigned seed)
 }
 
 
+// Generates random ranges [i, j] with i < j < size.
+vector<RMQTest::Range> RMQTest::generateQueries(size_t size, size_t queries)
+{
+    vector<Range> ranges(queries);
+
+    for (size_t q = 0; q < queries; q++)
+    {
+        size_t i = rand() % size;
+        size_t j = rand() % (size - 1);
+
+        if (i <= j) j++;
+        if (i > j) swap(i, j);
+
+        ranges[q] = Range(i, j);
+    }
+
+    return ranges;
+}
+
+
+// Generates random pairs of nodes (u, v) with u != v and u, v < size.
+vector<RMQTest::Range> RMQTest::generatePairs(size_t size, size_t queries)
+{
+    vector<Range> pairs(queries);
+
+    for (size_t q = 0; q < queries; q++)
+    {
+        pairs[q] = Range(rand() % size, rand() % size);
+    }
+
+    return pairs;
+}
+
+// Generates random deltas for range additions.
+vector<Num> RMQTest::generateDeltas(size_t size, size_t count)
+{
+    vector<Num> deltas(count);
+
+    for (size_t c = 0; c < count; c++)
+    {
+        deltas[c] = Num(rand() % (2 * size + 1)) - Num(size);
+    }
+
+    return deltas;
+}
+
+// Assigns new random values to the given number of random elements.
+// Returns the indices of the changed elements.
+vector<size_t> RMQTest::changeData(vector<Num>& data, size_t changes)
+{
+    const size_t size = data.size();
+
+    size_t maxVal = size * logF(size);
+    size_t shift = maxVal >> 2;
+
+    vector<size_t> indices(changes);
+
+    for (size_t c = 0; c < changes; c++)
+    {
+        size_t idx = rand() % size;
+
+        data[idx] = rand() % maxVal - shift;
+        indices[c] = idx;
+    }
+
+    return indices;
+}
+
+
 // Verifies that two RMQ algorithm create the same result.
 // Randomly picks index pairs and compares the result.
+// Also verifies that the batch queries of the second algorithm return the
+// same result as single queries.
 bool RMQTest::verify(const RMQ<Num>& rmq1, const RMQ<Num>& rmq2, size_t dataSize, size_t queries)
 {
     const vector<Num>& data = rmq1.data;
 
+    vector<Range> ranges = generateQueries(dataSize, queries);
+
+    vector<size_t> results(queries);
+    rmq2.batch(ranges.data(), queries, results.data());
+
     for (size_t q = 0; q < queries; q++)
     {
-        size_t i = rand() % dataSize;
-        size_t j = rand() % (dataSize - 1);
-
-        if (i <= j) j++;
-        if (i > j) swap(i, j);
+        size_t i = ranges[q].first;
+        size_t j = ranges[q].second;
 
         size_t min1 = rmq1(i, j);
         size_t min2 = rmq2(i, j);
 
         if (data[min1] != data[min2]) return false;
+        if (data[min2] != data[results[q]]) return false;
     }
 
     return true;
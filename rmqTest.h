@@ -5,10 +5,14 @@
 
 
 #include <chrono>
+#include <limits>
 
 #include "lca.hpp"
+#include "noPreRmq.hpp"
 #include "rmq.hpp"
 #include "plusMinusRmq.hpp"
+#include "scheduler.hpp"
+#include "simdArgmin.hpp"
 
 
 using namespace std::chrono;
@@ -22,6 +26,12 @@ class RMQTest
     // Used as result when making runtime tests.
     typedef std::pair<size_t, size_t> TimePair;
 
+    // A range [i, j] to run a query on.
+    typedef std::pair<size_t, size_t> Range;
+
+    // Used as result when measuring memory usage (in bytes).
+    typedef std::pair<size_t, size_t> MemoryPair;
+
     // Shortcut for vector class. (Avoids need for "std::" each time.)
     template<typename X> using vector = std::vector<X>;
 
@@ -49,6 +59,83 @@ public:
         return verify(rmq1, rmq2, dataSize, queries);
     }
 
+    // Verifies NoPreRMQ, i.e., simdArgmin(), for values of type V against a
+    // scalar scan (argminScalar()). Runs the given number of random queries
+    // and every length up to 200 (short ranges and odd lengths that do not
+    // fill whole vectors). For floating-point types, also runs the queries on
+    // data with NaNs and checks that the results stay within the ranges.
+    template<typename V>
+    static bool verifyNoPre(size_t dataSize, size_t queries, unsigned seed)
+    {
+        vector<Num> numbers = generateData(dataSize, seed);
+
+        // Few distinct values, so that minima occur multiple times.
+        vector<V> data(dataSize);
+        for (size_t k = 0; k < dataSize; k++) data[k] = V(numbers[k] % 101);
+
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        for (size_t len = 1; len <= 200 && len <= dataSize; len++)
+        {
+            size_t i = rand() % (dataSize - len + 1);
+            ranges.push_back(Range(i, i + len - 1));
+        }
+
+        NoPreRMQ<V> rmq(data);
+        rmq.processData();
+
+        for (const Range& r : ranges)
+        {
+            size_t minIdx = r.first + argminScalar(&data[r.first], r.second - r.first + 1);
+            if (rmq(r.first, r.second) != minIdx) return false;
+        }
+
+        if (!std::numeric_limits<V>::has_quiet_NaN) return true;
+
+        // Every 7th element and the whole first 200 elements are NaN.
+        for (size_t k = 0; k < dataSize; k += 7) data[k] = std::numeric_limits<V>::quiet_NaN();
+        for (size_t k = 0; k < 200 && k < dataSize; k++) data[k] = std::numeric_limits<V>::quiet_NaN();
+
+        for (const Range& r : ranges)
+        {
+            size_t minIdx = rmq(r.first, r.second);
+            if (minIdx < r.first || minIdx > r.second) return false;
+        }
+
+        return true;
+    }
+
+
+    // Verifies that the batches of T create the same results as single
+    // queries of S. Use it for algorithms whose single queries are slow.
+    template<typename S, typename T>
+    static bool verifyBatch(size_t dataSize, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, S>::value, "S must inherit from RMQ<>.");
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        S rmq1(data);
+        T rmq2(data);
+
+        rmq1.processData();
+        rmq2.processData();
+
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results(queries);
+
+        rmq2.batch(ranges.data(), queries, results.data());
+
+        for (size_t q = 0; q < queries; q++)
+        {
+            size_t minIdx = rmq1(ranges[q].first, ranges[q].second);
+            if (data[minIdx] != data[results[q]]) return false;
+        }
+
+        return true;
+    }
+
 
     // Determines the runtime of the given algorithm.
     // Returns the runtime for preprocessing and for queries.
@@ -66,6 +153,430 @@ public:
     }
 
 
+    // Determines the runtime of the given algorithm when binding its queries
+    // at compile time instead of calling them via RMQ<> (see staticQuery()).
+    // Returns the runtime for preprocessing and for queries.
+    template<typename T>
+    static TimePair getStaticRuntime(size_t dataSize, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+        T rmq(data);
+
+        // Preprocessing
+        size_t pTime = 0;
+        {
+            auto start = high_resolution_clock::now();
+
+            rmq.processData();
+
+            auto end = high_resolution_clock::now();
+            pTime = duration_cast<milliseconds>(end - start).count();
+        }
+
+        // Queries
+        size_t qTime = 0;
+        {
+            // Inlined queries have no side effects. Combine their results to
+            // prevent the compiler from removing them.
+            size_t check = 0;
+
+            auto start = high_resolution_clock::now();
+
+            for (size_t q = 0; q < queries; q++)
+            {
+                size_t i = rand() % dataSize;
+                size_t j = rand() % (dataSize - 1);
+
+                if (i <= j) j++;
+                if (i > j) std::swap(i, j);
+
+                check ^= staticQuery(rmq, i, j);
+            }
+
+            auto end = high_resolution_clock::now();
+            qTime = duration_cast<milliseconds>(end - start).count();
+
+            sink = check;
+        }
+
+        return TimePair(pTime, qTime);
+    }
+
+
+    // Determines the runtime of the given algorithm when running all queries
+    // as a single batch.
+    // Returns the runtime for the queries.
+    template<typename T>
+    static size_t getBatchRuntime(size_t dataSize, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers and queries.
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results(queries);
+
+        T rmq(data);
+        rmq.processData();
+
+        auto start = high_resolution_clock::now();
+
+        rmq.batch(ranges.data(), queries, results.data());
+
+        auto end = high_resolution_clock::now();
+        return duration_cast<milliseconds>(end - start).count();
+    }
+
+
+    // Determines the runtime of searching the minimum in ranges with the given
+    // length at random positions, once with argminScalar() and once with
+    // simdArgmin(). Shows whether scans as short as a block use vectors.
+    // Returns the runtime of the scalar and of the vectorized scans.
+    static TimePair getScanRuntime(size_t dataSize, size_t length, size_t scans, unsigned seed)
+    {
+        vector<Num> data = generateData(dataSize, seed);
+        vector<size_t> starts(scans);
+        for (size_t& sta : starts) sta = rand() % (dataSize - length + 1);
+
+        size_t sum = 0;
+
+        auto start = high_resolution_clock::now();
+
+        for (size_t sta : starts) sum += argminScalar(data.data() + sta, length);
+
+        auto mid = high_resolution_clock::now();
+
+        for (size_t sta : starts) sum += simdArgmin(data.data() + sta, length);
+
+        auto end = high_resolution_clock::now();
+
+        sink = sum;
+
+        return TimePair
+        (
+            duration_cast<milliseconds>(mid - start).count(),
+            duration_cast<milliseconds>(end - mid).count()
+        );
+    }
+
+
+    // Determines the runtime of the given algorithm when running all queries
+    // as a single interleaved batch (see RMQ::interleavedBatch()).
+    // Returns the runtime for the queries.
+    template<typename T>
+    static size_t getInterleavedRuntime(size_t dataSize, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers and queries.
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results(queries);
+
+        T rmq(data);
+        rmq.processData();
+
+        auto start = high_resolution_clock::now();
+
+        rmq.interleavedBatch(ranges.data(), queries, results.data());
+
+        auto end = high_resolution_clock::now();
+        return duration_cast<milliseconds>(end - start).count();
+    }
+
+    // Determines the runtime of the given algorithm when running all queries
+    // as a single batch in the given order (see scheduledBatch()).
+    // Returns the runtime for reordering and the queries.
+    template<typename T>
+    static size_t getScheduledRuntime(size_t dataSize, size_t queries, unsigned seed, QueryOrder order)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers and queries.
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results(queries);
+
+        T rmq(data);
+        rmq.processData();
+
+        auto start = high_resolution_clock::now();
+
+        scheduledBatch(rmq, ranges.data(), queries, results.data(), order);
+
+        auto end = high_resolution_clock::now();
+        return duration_cast<milliseconds>(end - start).count();
+    }
+
+    // Verifies that scheduledBatch() and batch() of the given algorithm
+    // create the same results.
+    template<typename T>
+    static bool verifyScheduled(size_t dataSize, size_t queries, unsigned seed, QueryOrder order)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results1(queries);
+        vector<size_t> results2(queries);
+
+        T rmq(data);
+        rmq.processData();
+
+        rmq.batch(ranges.data(), queries, results1.data());
+        scheduledBatch(rmq, ranges.data(), queries, results2.data(), order);
+
+        return results1 == results2;
+    }
+
+    // Verifies that interleavedBatch() and batch() of the given algorithm
+    // create the same results.
+    template<typename T>
+    static bool verifyInterleaved(size_t dataSize, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Range> ranges = generateQueries(dataSize, queries);
+        vector<size_t> results1(queries);
+        vector<size_t> results2(queries);
+
+        T rmq(data);
+        rmq.processData();
+
+        rmq.batch(ranges.data(), queries, results1.data());
+        rmq.interleavedBatch(ranges.data(), queries, results2.data());
+
+        return results1 == results2;
+    }
+
+
+    // Determines the pre-processing time of the given algorithm when using the
+    // given number of threads. T has to provide setThreadCount().
+    template<typename T>
+    static size_t getParallelRuntime(size_t dataSize, unsigned seed, size_t threads)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        T rmq(data);
+        rmq.setThreadCount(threads);
+
+        auto start = high_resolution_clock::now();
+
+        rmq.processData();
+
+        auto end = high_resolution_clock::now();
+        return duration_cast<milliseconds>(end - start).count();
+    }
+
+
+    // Measures the time to run rounds of changes and queries. Each round
+    // changes the values of some random elements, repairs the algorithm via
+    // update(), and then runs random queries.
+    // Returns the total runtime.
+    template<typename T>
+    static size_t getUpdateRuntime(size_t dataSize, size_t rounds, size_t changes, size_t queries, unsigned seed)
+    {
+        return getChangeRuntime<T>
+        (
+            dataSize, rounds, changes, queries, seed,
+            [](T& rmq, const vector<size_t>& indices)
+            {
+                rmq.update(indices.data(), indices.size());
+            }
+        );
+    }
+
+    // Measures the time to run rounds of changes and queries. Each round
+    // changes the values of some random elements, pre-processes the data
+    // again, and then runs random queries.
+    // Returns the total runtime.
+    template<typename T>
+    static size_t getRebuildRuntime(size_t dataSize, size_t rounds, size_t changes, size_t queries, unsigned seed)
+    {
+        return getChangeRuntime<T>
+        (
+            dataSize, rounds, changes, queries, seed,
+            [](T& rmq, const vector<size_t>&)
+            {
+                rmq.processData();
+            }
+        );
+    }
+
+    // Verifies that the given algorithm creates correct results after its
+    // data changed and it was repaired via update().
+    // Compares it against NoPreRMQ after each round of changes.
+    template<typename T>
+    static bool verifyUpdates(size_t dataSize, size_t rounds, size_t changes, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        NoPreRMQ<Num> rmq1(data);
+        T rmq2(data);
+
+        rmq1.processData();
+        rmq2.processData();
+
+        for (size_t r = 0; r < rounds; r++)
+        {
+            vector<size_t> indices = changeData(data, changes);
+            rmq2.update(indices.data(), indices.size());
+
+            if (!verify(rmq1, rmq2, dataSize, queries)) return false;
+        }
+
+        return true;
+    }
+
+
+    // Measures the time to run rounds of range additions and queries. Each
+    // round adds random deltas to random ranges and then runs random queries.
+    // If batched is true, all additions of a round are applied at once.
+    // Returns the total runtime.
+    template<typename T>
+    static size_t getRangeAddRuntime(size_t dataSize, size_t rounds, size_t adds, size_t queries, unsigned seed, bool batched)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        T rmq(data);
+        rmq.processData();
+
+        size_t time = 0;
+
+        for (size_t r = 0; r < rounds; r++)
+        {
+            // Generate additions and queries outside of the measured time.
+            vector<Range> addRanges = generateQueries(dataSize, adds);
+            vector<Num> deltas = generateDeltas(dataSize, adds);
+            vector<Range> ranges = generateQueries(dataSize, queries);
+            vector<size_t> results(queries);
+
+            auto start = high_resolution_clock::now();
+
+            if (batched)
+            {
+                rmq.rangeAdd(addRanges.data(), deltas.data(), adds);
+            }
+            else
+            {
+                for (size_t a = 0; a < adds; a++)
+                {
+                    rmq.rangeAdd(addRanges[a].first, addRanges[a].second, deltas[a]);
+                }
+            }
+
+            rmq.batch(ranges.data(), queries, results.data());
+
+            auto end = high_resolution_clock::now();
+            time += duration_cast<microseconds>(end - start).count();
+        }
+
+        return time / 1000;
+    }
+
+    // Verifies that the given algorithm creates correct results after range
+    // additions. Applies the same additions to a copy of the data and compares
+    // the algorithm against NoPreRMQ on that copy after each round. Checks
+    // single queries, batch(), and interleavedBatch().
+    template<typename T>
+    static bool verifyRangeAdds(size_t dataSize, size_t rounds, size_t adds, size_t queries, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+        vector<Num> shifted = data;
+
+        NoPreRMQ<Num> rmq1(shifted);
+        T rmq2(data);
+
+        rmq1.processData();
+        rmq2.processData();
+
+        for (size_t r = 0; r < rounds; r++)
+        {
+            vector<Range> addRanges = generateQueries(dataSize, adds);
+            vector<Num> deltas = generateDeltas(dataSize, adds);
+
+            // Alternate between single and batched additions.
+            if (r % 2 == 0)
+            {
+                for (size_t a = 0; a < adds; a++)
+                {
+                    rmq2.rangeAdd(addRanges[a].first, addRanges[a].second, deltas[a]);
+                }
+            }
+            else
+            {
+                rmq2.rangeAdd(addRanges.data(), deltas.data(), adds);
+            }
+
+            for (size_t a = 0; a < adds; a++)
+            {
+                for (size_t k = addRanges[a].first; k <= addRanges[a].second; k++)
+                {
+                    shifted[k] += deltas[a];
+                }
+            }
+
+            vector<Range> ranges = generateQueries(dataSize, queries);
+            vector<size_t> results(queries);
+            vector<size_t> interleaved(queries);
+            rmq2.batch(ranges.data(), queries, results.data());
+            rmq2.interleavedBatch(ranges.data(), queries, interleaved.data());
+
+            for (size_t q = 0; q < queries; q++)
+            {
+                size_t i = ranges[q].first;
+                size_t j = ranges[q].second;
+
+                size_t min1 = rmq1(i, j);
+                size_t min2 = rmq2(i, j);
+
+                if (shifted[min1] != shifted[min2]) return false;
+                if (shifted[min2] != shifted[results[q]]) return false;
+                if (shifted[min2] != shifted[interleaved[q]]) return false;
+                if (shifted[min2] != rmq2.value(min2)) return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    // Determines the memory used by the given algorithm.
+    // Returns the peak memory during preprocessing and the memory still in use
+    // afterwards. Both exclude the input data.
+    template<typename T>
+    static MemoryPair getMemory(size_t dataSize, unsigned seed)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        startTracking();
+
+        T rmq(data);
+        rmq.processData();
+
+        return stopTracking();
+    }
+
+
     // Verifies that two RMQ algorithm create the same result.
     // Randomly picks index pairs and compares the result.
     template<typename T>
@@ -83,31 +594,36 @@ public:
         rmq1.processData();
         rmq2.processData();
 
-        return verify(rmq1, rmq2, dataSize, queries);
+        return verify(rmq2, rmq1, dataSize, queries);
     }
 
-    // Determines the runtime of the given algorithm.
+    // Determines the runtime of the given algorithm on data that satisfies
+    // the +-1 property.
     // Returns the runtime for preprocessing and for queries.
+    template<typename T = PlusMinusRMQ<Num>>
     static TimePair getPlusMinusRuntime(size_t dataSize, size_t queries, unsigned seed)
     {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
         // Generate random numbers.
         vector<Num> data = generatePlusMinus(dataSize, seed);
 
         // Run test.
-        PlusMinusRMQ<Num> rmq(data);
+        T rmq(data);
         return getRuntime(rmq, dataSize, queries);
     }
 
 
     // Measures the time needed to preprocess and to run queries using the
-    // given RMQ algorithm.
+    // given RMQ algorithm. Pre-processing uses the given number of threads.
     template<typename T>
-    static TimePair getAncestorRuntime(size_t treeSize, size_t queries, unsigned seed)
+    static TimePair getAncestorRuntime(size_t treeSize, size_t queries, unsigned seed, size_t threads = defaultThreadCount())
     {
         static_assert(std::is_base_of<RMQ<size_t>, T>::value, "T must inherit from RMQ<size_t>.");
 
         Tree tree = generateTree(treeSize, seed);
         LCA<T> lca(tree);
+        lca.setThreadCount(threads);
 
 
         // Preprocessing
@@ -124,6 +640,10 @@ public:
         // Queries
         size_t qTime = 0;
         {
+            // LCA<> binds its RMQ at compile time. Combine the results to
+            // prevent the compiler from removing inlined queries.
+            size_t check = 0;
+
             auto start = high_resolution_clock::now();
 
             for (size_t q = 0; q < queries; q++)
@@ -131,19 +651,218 @@ public:
                 size_t uId = rand() % treeSize;
                 size_t vId = (uId + 1 + (rand() % (treeSize - 1))) % treeSize;
 
-                lca(uId, vId);
+                check ^= lca(uId, vId);
             }
 
             auto end = high_resolution_clock::now();
             qTime = duration_cast<milliseconds>(end - start).count();
+
+            sink = check;
         }
 
         return TimePair(pTime, qTime);
     }
 
 
+    // Determines the runtime of the given LCA algorithm. L has to be
+    // constructible from a Tree and provide processData() and
+    // operator()(uId, vId).
+    // Returns the runtime for preprocessing and for queries.
+    template<typename L>
+    static TimePair getLcaRuntime(size_t treeSize, size_t queries, unsigned seed)
+    {
+        Tree tree = generateTree(treeSize, seed);
+        L lca(tree);
+
+
+        // Preprocessing
+        size_t pTime = 0;
+        {
+            auto start = high_resolution_clock::now();
+
+            lca.processData();
+
+            auto end = high_resolution_clock::now();
+            pTime = duration_cast<milliseconds>(end - start).count();
+        }
+
+        // Queries
+        size_t qTime = 0;
+        {
+            size_t check = 0;
+
+            auto start = high_resolution_clock::now();
+
+            for (size_t q = 0; q < queries; q++)
+            {
+                size_t uId = rand() % treeSize;
+                size_t vId = (uId + 1 + (rand() % (treeSize - 1))) % treeSize;
+
+                check ^= lca(uId, vId);
+            }
+
+            auto end = high_resolution_clock::now();
+            qTime = duration_cast<milliseconds>(end - start).count();
+
+            sink = check;
+        }
+
+        return TimePair(pTime, qTime);
+    }
+
+    // Determines the memory the given LCA algorithm allocates while
+    // pre-processing a random tree, without the tree itself.
+    // Returns the peak and the retained number of bytes.
+    template<typename L>
+    static MemoryPair getLcaMemory(size_t treeSize, unsigned seed)
+    {
+        Tree tree = generateTree(treeSize, seed);
+
+        startTracking();
+
+        L lca(tree);
+        lca.processData();
+
+        return stopTracking();
+    }
+
+    // Verifies that the Euler tour of a random tree computed with the given
+    // number of threads equals the sequential one (E, L, and R).
+    static bool verifyEulerTour(size_t treeSize, unsigned seed, size_t threads);
+
+    // Verifies that a random tree with 32-bit node IDs (Tree32) has the same
+    // Euler tours as the same tree with Tree, both sequential and with the
+    // given number of threads, and the same compact Euler tour.
+    static bool verifyTree32(size_t treeSize, unsigned seed, size_t threads);
+
+    // Verifies that two LCA algorithms create the same result.
+    // Randomly picks node pairs and compares the result.
+    template<typename S, typename T>
+    static bool verifyLca(size_t treeSize, size_t queries, unsigned seed)
+    {
+        Tree tree = generateTree(treeSize, seed);
+
+        S lca1(tree);
+        T lca2(tree);
+
+        lca1.processData();
+        lca2.processData();
+
+        for (size_t q = 0; q < queries; q++)
+        {
+            size_t uId = rand() % treeSize;
+            size_t vId = rand() % treeSize;
+
+            if (lca1(uId, vId) != lca2(uId, vId)) return false;
+        }
+
+        return true;
+    }
+
+
+    // Determines the time the given LCA algorithm needs to pre-process a
+    // random tree and to answer random node pairs with one call of batch().
+    // Returns the runtime for preprocessing and for the batch.
+    template<typename L>
+    static TimePair getLcaBatchRuntime(size_t treeSize, size_t queries, unsigned seed)
+    {
+        return getLcaBatchRuntime<L>
+        (
+            treeSize, queries, seed,
+            [](const L& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                lca.batch(pairs.data(), pairs.size(), results.data());
+            }
+        );
+    }
+
+    // Same as getLcaBatchRuntime(), but uses interleavedBatch().
+    template<typename L>
+    static TimePair getLcaInterleavedRuntime(size_t treeSize, size_t queries, unsigned seed)
+    {
+        return getLcaBatchRuntime<L>
+        (
+            treeSize, queries, seed,
+            [](const L& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                lca.interleavedBatch(pairs.data(), pairs.size(), results.data());
+            }
+        );
+    }
+
+    // Same as getLcaBatchRuntime(), but runs the batch with scheduledBatch()
+    // in the given order. Sorting is included in the runtime of the batch.
+    template<typename L>
+    static TimePair getLcaScheduledRuntime(size_t treeSize, size_t queries, unsigned seed, QueryOrder order)
+    {
+        return getLcaBatchRuntime<L>
+        (
+            treeSize, queries, seed,
+            [treeSize, order](const L& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                scheduledBatch(lca, treeSize, pairs.data(), pairs.size(), results.data(), order);
+            }
+        );
+    }
+
+    // Verifies that the batches of T create the same results as single
+    // queries of S.
+    template<typename S, typename T>
+    static bool verifyLcaBatch(size_t treeSize, size_t queries, unsigned seed)
+    {
+        return verifyLcaBatch<S, T>
+        (
+            treeSize, queries, seed,
+            [](const T& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                lca.batch(pairs.data(), pairs.size(), results.data());
+            }
+        );
+    }
+
+    // Same as verifyLcaBatch(), but uses interleavedBatch().
+    template<typename S, typename T>
+    static bool verifyLcaInterleaved(size_t treeSize, size_t queries, unsigned seed)
+    {
+        return verifyLcaBatch<S, T>
+        (
+            treeSize, queries, seed,
+            [](const T& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                lca.interleavedBatch(pairs.data(), pairs.size(), results.data());
+            }
+        );
+    }
+
+    // Same as verifyLcaBatch(), but uses scheduledBatch() in the given order.
+    template<typename S, typename T>
+    static bool verifyLcaScheduled(size_t treeSize, size_t queries, unsigned seed, QueryOrder order)
+    {
+        return verifyLcaBatch<S, T>
+        (
+            treeSize, queries, seed,
+            [treeSize, order](const T& lca, const vector<Range>& pairs, vector<size_t>& results)
+            {
+                scheduledBatch(lca, treeSize, pairs.data(), pairs.size(), results.data(), order);
+            }
+        );
+    }
+
+
 private:
 
+    // Receives results of queries in runtime tests.
+    static volatile size_t sink;
+
+
+    // Starts counting the bytes allocated on the heap, beginning at zero.
+    static void startTracking();
+
+    // Stops counting the bytes allocated on the heap.
+    // Returns the peak and the retained number of bytes since startTracking().
+    static MemoryPair stopTracking();
+
+
     // Generates a list of random numbers with the given size.
     static vector<Num> generateData(size_t size, unsigned seed);
 
@@ -153,6 +872,112 @@ private:
     // Generates a random tree of the given size.
     static Tree generateTree(size_t size, unsigned seed);
 
+    // Generates random ranges [i, j] with i < j < size.
+    static vector<Range> generateQueries(size_t size, size_t queries);
+
+    // Generates random pairs of nodes (u, v) with u, v < size.
+    static vector<Range> generatePairs(size_t size, size_t queries);
+
+    // Generates random deltas for range additions.
+    static vector<Num> generateDeltas(size_t size, size_t count);
+
+    // Assigns new random values to the given number of random elements.
+    // Returns the indices of the changed elements.
+    static vector<size_t> changeData(vector<Num>& data, size_t changes);
+
+
+    // Verifies that run(lca, pairs, results) with T creates the same results
+    // as single queries of S.
+    template<typename S, typename T, typename F>
+    static bool verifyLcaBatch(size_t treeSize, size_t queries, unsigned seed, F run)
+    {
+        Tree tree = generateTree(treeSize, seed);
+        vector<Range> pairs = generatePairs(treeSize, queries);
+        vector<size_t> results(queries);
+
+        S lca1(tree);
+        T lca2(tree);
+
+        lca1.processData();
+        lca2.processData();
+
+        run(lca2, pairs, results);
+
+        for (size_t q = 0; q < queries; q++)
+        {
+            if (lca1(pairs[q].first, pairs[q].second) != results[q]) return false;
+        }
+
+        return true;
+    }
+
+    // Determines the time the given LCA algorithm needs to pre-process a
+    // random tree and to answer random node pairs with run(lca, pairs,
+    // results).
+    template<typename L, typename F>
+    static TimePair getLcaBatchRuntime(size_t treeSize, size_t queries, unsigned seed, F run)
+    {
+        Tree tree = generateTree(treeSize, seed);
+        vector<Range> pairs = generatePairs(treeSize, queries);
+        vector<size_t> results(queries);
+
+        L lca(tree);
+
+        auto start = high_resolution_clock::now();
+
+        lca.processData();
+
+        auto mid = high_resolution_clock::now();
+
+        run(lca, pairs, results);
+
+        auto end = high_resolution_clock::now();
+
+        return TimePair
+        (
+            duration_cast<milliseconds>(mid - start).count(),
+            duration_cast<milliseconds>(end - mid).count()
+        );
+    }
+
+    // Measures the time to run rounds of changes and queries. After changing
+    // the data, apply(rmq, indices) is called to prepare the algorithm for
+    // queries again.
+    template<typename T, typename F>
+    static size_t getChangeRuntime(size_t dataSize, size_t rounds, size_t changes, size_t queries, unsigned seed, F apply)
+    {
+        static_assert(std::is_base_of<RMQ<Num>, T>::value, "T must inherit from RMQ<>.");
+
+        // Generate random numbers.
+        vector<Num> data = generateData(dataSize, seed);
+
+        T rmq(data);
+        rmq.processData();
+
+        size_t time = 0;
+
+        for (size_t r = 0; r < rounds; r++)
+        {
+            // Generate changes and queries outside of the measured time.
+            vector<Num> newData = data;
+            vector<size_t> indices = changeData(newData, changes);
+            vector<Range> ranges = generateQueries(dataSize, queries);
+            vector<size_t> results(queries);
+
+            auto start = high_resolution_clock::now();
+
+            for (size_t idx : indices) data[idx] = newData[idx];
+            apply(rmq, indices);
+
+            rmq.batch(ranges.data(), queries, results.data());
+
+            auto end = high_resolution_clock::now();
+            time += duration_cast<microseconds>(end - start).count();
+        }
+
+        return time / 1000;
+    }
+
 
     // Verifies that two RMQ algorithm create the same result.
     // Randomly picks index pairs and compares the result.
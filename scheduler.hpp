@@ -0,0 +1,125 @@
+// Implements a scheduler that reorders a batch of queries to improve the
+// locality of their memory accesses. Random queries touch unrelated parts of
+// the data structures one after another. After sorting, consecutive queries
+// have close endpoints and often use the same cache lines. The results are
+// written in the original order.
+
+#ifndef __Scheduler_HPP__
+#define __Scheduler_HPP__
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "log.hpp"
+#include "rmq.hpp"
+
+
+// The orders in which the scheduler runs queries.
+enum class QueryOrder
+{
+    // Sorts by the block of i (about sqrt(count) blocks), then by j.
+    Block,
+
+    // Sorts by the position of (i, j) on a Hilbert curve.
+    Hilbert
+};
+
+
+// Returns the position of the point (x, y) on a Hilbert curve that covers a
+// grid of 2^bits x 2^bits points. Requires bits <= 32.
+inline uint64_t hilbertIndex(uint64_t x, uint64_t y, unsigned bits)
+{
+    const uint64_t max = (uint64_t(1) << bits) - 1;
+    uint64_t d = 0;
+
+    for (uint64_t s = uint64_t(1) << bits >> 1; s > 0; s >>= 1)
+    {
+        uint64_t rx = (x & s) > 0;
+        uint64_t ry = (y & s) > 0;
+
+        d += s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant: if ry = 0, mirror (if rx = 1) and then swap x
+        // and y. Without branches since the quadrants are random.
+        uint64_t mirror = -(rx & (ry ^ 1)) & max;
+        x ^= mirror;
+        y ^= mirror;
+
+        uint64_t swap = (x ^ y) & -(ry ^ 1);
+        x ^= swap;
+        y ^= swap;
+    }
+
+    return d;
+}
+
+
+// Performs a query for each of the given ranges on the given engine, but runs
+// them in the given order. The engine can be anything with a method
+// batch(ranges, count, results), e.g., an RMQ or LCA algorithm; n bounds the
+// values in the ranges (elements or nodes). Results are written as by
+// RMQ::batch(), i.e., results[q] is the result for ranges[q]. The batch is
+// bound to E at compile time (see staticQuery()). Requires n <= 2^32.
+template<typename E>
+void scheduledBatch(const E& engine, size_t n, const std::pair<size_t, size_t>* ranges, size_t count, size_t* results, QueryOrder order)
+{
+    // Keys hold both values of a range in 64 bits.
+    assert(uint64_t(n) <= uint64_t(1) << 32);
+
+    // Determine the key of each query.
+    std::vector<std::pair<uint64_t, size_t>> keys(count);
+
+    if (order == QueryOrder::Block)
+    {
+        // About sqrt(count) blocks of i.
+        const size_t nBits = logC(std::max<size_t>(n, 2));
+        const size_t cBits = logF(std::max<size_t>(count, 1)) / 2;
+        const size_t blockBits = nBits > cBits ? nBits - cBits : 0;
+
+        for (size_t q = 0; q < count; q++)
+        {
+            uint64_t block = ranges[q].first >> blockBits;
+            keys[q] = std::make_pair((block << 32) | ranges[q].second, q);
+        }
+    }
+    else
+    {
+        const unsigned bits = logC(std::max<size_t>(n, 2));
+
+        for (size_t q = 0; q < count; q++)
+        {
+            keys[q] = std::make_pair(hilbertIndex(ranges[q].first, ranges[q].second, bits), q);
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+
+    // Run queries in the new order.
+    std::vector<std::pair<size_t, size_t>> sorted(count);
+    for (size_t p = 0; p < count; p++) sorted[p] = ranges[keys[p].second];
+
+    std::vector<size_t> sortedResults(count);
+    engine.E::batch(sorted.data(), count, sortedResults.data());
+
+    // Write results in the original order.
+    for (size_t p = 0; p < count; p++) results[keys[p].second] = sortedResults[p];
+}
+
+// Same as above for an RMQ algorithm, where n is the size of its data.
+template<typename R>
+void scheduledBatch(const R& rmq, const std::pair<size_t, size_t>* ranges, size_t count, size_t* results, QueryOrder order)
+{
+    static_assert
+    (
+        std::is_base_of<RMQ<typename R::ValueType>, R>::value,
+        "R must inherit from RMQ<>."
+    );
+
+    scheduledBatch(rmq, rmq.data.size(), ranges, count, results, order);
+}
+
+#endif
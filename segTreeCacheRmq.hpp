@@ -5,9 +5,12 @@
 #define __SegTreeCacheRmq_HPP__
 
 
+#include <algorithm>
 #include <limits>
 
 #include "log.hpp"
+#include "interleave.hpp"
+#include "parallel.hpp"
 #include "rmq.hpp"
 
 
@@ -49,72 +52,91 @@ public:
         size_t treeSize = (1 << height) - 1;
         tree.resize(treeSize, Node());
 
-        // Indices of the leafs.
-        vector<size_t> leafIndices;
-        leafIndices.reserve(treeSize);
+        // The van Emde Boas layout first stores the top half of the tree and
+        // then all subtrees below it, one after another. These subtrees are
+        // independent of each other. Hence, we build them (structure and
+        // minima) in parallel and then process the top half.
 
-        {
-            vector<size_t> leafStack;
-            leafStack.reserve(1 << (height >> 1));
+        size_t topHeight = height >> 1;
+        size_t botHeight = (height + 1) >> 1;
 
-            // Build tree structure recursively.
-            buildTree(0, height, leafIndices, leafStack);
-        }
+        size_t topSize = (1 << topHeight) - 1;
+        size_t botSize = (1 << botHeight) - 1;
 
-        // The structure of the tree is build.
-        // We need to add data and cut unwanted edges.
+        // The number of leaves of each bottom subtree.
+        size_t botLeaves = (botSize + 1) >> 1;
 
-        // Initialise leaves.
-        for (size_t i = 0; i < n; i++)
+        // Build the structure of the top half.
         {
-            size_t idx = leafIndices[i];
-            Node& node = tree[idx];
+            vector<size_t> leafIndices;
+            leafIndices.reserve(topSize);
 
-            node.toIdx = i;
-            node.minIdx = i;
-        }
+            vector<size_t> leafStack;
+            leafStack.reserve(1 << (topHeight >> 1));
 
-        // Leaves that we do not keep.
-        for (size_t i = n; i < leafIndices.size(); i++)
-        {
-            size_t idx = leafIndices[i];
-            Node& node = tree[idx];
+            buildTree(0, topHeight, leafIndices, leafStack);
+
+            // Connect the leaves of the top half with the bottom subtrees.
+            for (size_t ptr = 0, chIdx = topSize; ptr < leafIndices.size(); ptr++)
+            {
+                Node& pNode = tree[leafIndices[ptr]];
 
-            node.minIdx = InvalidIndex;
+                pNode.left  = &tree[chIdx]; chIdx += botSize;
+                pNode.right = &tree[chIdx]; chIdx += botSize;
+            }
         }
 
-        // Process tree bottom up.
-        for (size_t i = tree.size() - 1; i < tree.size(); i--)
+        // Build the bottom subtrees.
+        parallelFor(0, 2 * ((topSize + 1) >> 1), threadCount, 1, [&](size_t sta, size_t end)
         {
-            Node& node = tree[i];
+            vector<size_t> leafIndices;
+            leafIndices.reserve(botLeaves);
 
-            // Skip leaves.
-            if (node.left == nullptr) continue;
+            vector<size_t> leafStack;
+            leafStack.reserve(1 << (botHeight >> 1));
 
-            // Left valid?
-            if (node.left->minIdx == InvalidIndex)
+            for (size_t sub = sta; sub < end; sub++)
             {
-                // No valid children.
-                // Flag as invalid and continue with next.
-                node.minIdx = InvalidIndex;
-                continue;
+                size_t rootIdx = topSize + sub * botSize;
+
+                leafIndices.clear();
+                buildTree(rootIdx, botHeight, leafIndices, leafStack);
+
+                initLeaves(leafIndices, sub * botLeaves);
+                processNodes(rootIdx, rootIdx + botSize);
             }
+        });
 
-            node.toIdx = node.left->toIdx;
-            node.minIdx = node.left->minIdx;
+        // Process the top half.
+        processNodes(0, topSize);
+    }
 
+    // Sets how many threads the pre-processing uses.
+    // By default, it uses one thread per core.
+    void setThreadCount(size_t count)
+    {
+        threadCount = std::max<size_t>(count, 1);
+    }
 
-            // Right valid?
-            if (node.right->minIdx == InvalidIndex)
-            {
-                // No. Remove pointer and continue.
-                node.right = nullptr;
-                continue;
-            }
+    // Repairs the tree after the value of data[i] has changed.
+    // The tree only stores a reference to the data. Hence, the caller changes
+    // the value and then calls this function.
+    void update(size_t i)
+    {
+        update(&i, 1);
+    }
 
-            node.toIdx = node.right->toIdx;
-            node.minIdx = this->minIndex(node.minIdx, node.right->minIdx);
-        }
+    // Repairs the tree after the values of data[] at the given indices have
+    // changed. Each node is repaired at most once, even if it is an ancestor
+    // of multiple changed elements.
+    void update(const size_t* indices, size_t count)
+    {
+        if (count == 0) return;
+
+        vector<size_t> sorted(indices, indices + count);
+        std::sort(sorted.begin(), sorted.end());
+
+        updateNode(&tree[0], sorted.data(), sorted.data() + sorted.size());
     }
 
     // Performs a query on the given data and given range.
@@ -199,12 +221,274 @@ public:
         return minIdx;
     }
 
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the values of the range's endpoints for a later query into
+            // the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeCacheRMQ<T>::operator()(r.first, r.second);
+        }
+    }
+
+    // Performs a query for each of the given ranges.
+    // Runs InterleaveWidth queries at once; see interleave.hpp and
+    // RMQ::interleavedBatch().
+    void interleavedBatch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        interleave<InterleaveWidth, Walk>
+        (
+            count,
+            [&](Walk& w, size_t q)
+            {
+                w.q = q;
+                w.i = ranges[q].first;
+                w.j = ranges[q].second;
+                w.minIdx = w.i;
+                w.pending = InvalidIndex;
+                w.phase = 0;
+                w.node = &tree[0];
+
+                prefetch(&this->data[w.i]);
+                prefetchChildren(w.node);
+            },
+            [&](Walk& w)
+            {
+                return walkStep(w, results);
+            }
+        );
+    }
+
 
 private:
 
     // Stores the nodes of the segment tree.
     std::vector<Node> tree;
 
+    // The number of threads used for pre-processing.
+    size_t threadCount = defaultThreadCount();
+
+    // The number of queries interleavedBatch() runs at once.
+    static constexpr size_t InterleaveWidth = 16;
+
+    // The state of a query in interleavedBatch(). It follows the same path
+    // as operator(), one node per step.
+    struct Walk
+    {
+        // The query and its range.
+        size_t q;
+        size_t i;
+        size_t j;
+
+        // The current minimum and an index whose value has been prefetched
+        // to compare it with the minimum in the next step.
+        size_t minIdx;
+        size_t pending;
+
+        // 0: Go down until paths to i and j split.
+        // 1: Go down left and search for i.
+        // 2: Go down right and search for j.
+        // 3: Done.
+        int phase;
+
+        // The current node (its children have been prefetched) and the node
+        // at which the search for j starts.
+        const Node* node;
+        const Node* split;
+    };
+
+
+    // Prefetches the children of the given node.
+    static void prefetchChildren(const Node* node)
+    {
+        if (node->left != nullptr) prefetch(node->left);
+        if (node->right != nullptr) prefetch(node->right);
+    }
+
+    // Runs the next step of the given query, i.e., processes one node.
+    // Returns true and writes the result if the query is done.
+    bool walkStep(Walk& w, size_t* results) const
+    {
+        if (w.pending != InvalidIndex)
+        {
+            w.minIdx = this->minIndex(w.minIdx, w.pending);
+            w.pending = InvalidIndex;
+        }
+
+        const Node* node = w.node;
+
+        if (w.phase == 0)
+        {
+            if (w.j <= node->left->toIdx)
+            {
+                // Go left.
+                w.node = node->left;
+            }
+            else if (w.i > node->left->toIdx)
+            {
+                // Go right.
+                w.node = node->right;
+            }
+            else
+            {
+                // Split paths.
+                w.split = node->right;
+                w.node = node->left;
+                w.phase = 1;
+            }
+        }
+        else if (w.phase == 1)
+        {
+            if (node->left == nullptr)
+            {
+                // Base case.
+                w.pending = node->minIdx;
+                w.node = w.split;
+                w.phase = 2;
+            }
+            else if (w.i <= node->left->toIdx)
+            {
+                // Get minimum from right node and go left.
+                w.pending = node->right->minIdx;
+                w.node = node->left;
+            }
+            else
+            {
+                // Go right.
+                w.node = node->right;
+            }
+        }
+        else if (w.phase == 2)
+        {
+            if (node->toIdx == w.j)
+            {
+                // Base case.
+                w.pending = node->minIdx;
+                w.phase = 3;
+            }
+            else if (w.j <= node->left->toIdx)
+            {
+                // Go left.
+                w.node = node->left;
+            }
+            else
+            {
+                // Get minimum from left node and go right.
+                w.pending = node->left->minIdx;
+                w.node = node->right;
+            }
+        }
+        else
+        {
+            results[w.q] = w.minIdx;
+            return true;
+        }
+
+        if (w.pending != InvalidIndex) prefetch(&this->data[w.pending]);
+        if (w.phase != 3) prefetchChildren(w.node);
+
+        return false;
+    }
+
+
+    // Initialises the given leaves. They represent the elements starting at
+    // index frIdx. Leaves of elements that do not exist are flagged as
+    // invalid.
+    void initLeaves(const vector<size_t>& leafIndices, size_t frIdx)
+    {
+        const size_t n = this->data.size();
+
+        for (size_t ptr = 0; ptr < leafIndices.size(); ptr++)
+        {
+            Node& node = tree[leafIndices[ptr]];
+            size_t i = frIdx + ptr;
+
+            if (i < n)
+            {
+                node.toIdx = i;
+                node.minIdx = i;
+            }
+            else
+            {
+                // Leaves that we do not keep.
+                node.minIdx = InvalidIndex;
+            }
+        }
+    }
+
+    // Determines the minimum of all inner nodes in tree[sta], ..., tree[end - 1]
+    // and cuts unwanted edges. The children of these nodes have to be processed
+    // already or be inside the range.
+    void processNodes(size_t sta, size_t end)
+    {
+        // Process tree bottom up. In the van Emde Boas layout, each node is
+        // stored before its children.
+        for (size_t i = end - 1; i + 1 > sta; i--)
+        {
+            Node& node = tree[i];
+
+            // Skip leaves.
+            if (node.left == nullptr) continue;
+
+            // Left valid?
+            if (node.left->minIdx == InvalidIndex)
+            {
+                // No valid children.
+                // Flag as invalid and continue with next.
+                node.minIdx = InvalidIndex;
+                continue;
+            }
+
+            node.toIdx = node.left->toIdx;
+            node.minIdx = node.left->minIdx;
+
+
+            // Right valid?
+            if (node.right->minIdx == InvalidIndex)
+            {
+                // No. Remove pointer and continue.
+                node.right = nullptr;
+                continue;
+            }
+
+            node.toIdx = node.right->toIdx;
+            node.minIdx = this->minIndex(node.minIdx, node.right->minIdx);
+        }
+    }
+
+    // Repairs the subtree of the given node after the values of data[] at the
+    // indices in [sta, end) have changed. These indices have to be sorted and
+    // inside the range of the node.
+    void updateNode(Node* node, const size_t* sta, const size_t* end)
+    {
+        // Leaves always store their own index.
+        if (node->left == nullptr) return;
+
+        // Split the indices into those of the left and right child.
+        const size_t* mid = std::upper_bound(sta, end, node->left->toIdx);
+
+        if (sta != mid) updateNode(node->left, sta, mid);
+        if (mid != end) updateNode(node->right, mid, end);
+
+        node->minIdx = node->left->minIdx;
+
+        if (node->right != nullptr)
+        {
+            node->minIdx = this->minIndex(node->minIdx, node->right->minIdx);
+        }
+    }
+
     // Recursively builds tree.
     void buildTree(size_t rootIdx, size_t height, vector<size_t>& leafIndices, vector<size_t>& leafStack)
     {
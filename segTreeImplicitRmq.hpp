@@ -0,0 +1,106 @@
+// Represents a RMQ that uses a segment tree without pointers to run queries.
+// The tree is stored implicitly in an array: node p has the children 2p and
+// 2p + 1, and the leaves n, ..., 2n - 1 represent the elements 0, ..., n - 1.
+// Only the minimum of each inner node is stored.
+// Runtime: O(n) | O(log n)
+
+#ifndef __SegTreeImplicitRmq_HPP__
+#define __SegTreeImplicitRmq_HPP__
+
+
+#include "rmq.hpp"
+
+
+template
+<
+    typename T,
+    // The integer type used to store indices in the tree. It has to be able
+    // to represent all indices of the data, e.g., uint32_t if n < 2^32.
+    typename Index = size_t
+>
+class SegTreeImplicitRMQ : public RMQ<T>
+{
+public:
+
+    // Constructor.
+    SegTreeImplicitRMQ(const std::vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        n = this->data.size();
+
+        // Inner nodes are 1, ..., n - 1. Index 0 is not used.
+        tree.resize(n);
+
+        // Build tree bottom-up.
+        for (size_t p = n - 1; p > 0 && p < n; p--)
+        {
+            tree[p] = Index(this->minIndex(nodeMin(2 * p), nodeMin(2 * p + 1)));
+        }
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        size_t minIdx = i;
+
+        // Go up from both leaves. [l, r) are the nodes of the current layer
+        // that are in the range and whose parents are not.
+        for (size_t l = i + n, r = j + n + 1; l < r; l >>= 1, r >>= 1)
+        {
+            // Is l a right child? Then its parent is not in range.
+            if (l & 1) minIdx = this->minIndex(minIdx, nodeMin(l++));
+
+            // Is r - 1 a left child? Then its parent is not in range.
+            if (r & 1) minIdx = this->minIndex(minIdx, nodeMin(--r));
+        }
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the lowest inner nodes of a later query and the values of
+            // its endpoints into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&tree[(r.first + n) >> 1]);
+                prefetch(&tree[(r.second + n) >> 1]);
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeImplicitRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The size of the data.
+    size_t n = 0;
+
+    // The index of the minimum of each inner node.
+    std::vector<Index> tree;
+
+
+    // Returns the index of the minimum in the subtree of node p.
+    size_t nodeMin(size_t p) const
+    {
+        return p >= n ? p - n : tree[p];
+    }
+};
+
+#endif
@@ -0,0 +1,290 @@
+// Represents a RMQ that uses a segment tree with lazy propagation to run
+// queries. In addition to queries, it allows to add a constant to all elements
+// in a range. These additions are stored in the tree and do not change the
+// given data. Queries then return the index of the minimum of the values
+// data[k] + (sum of all deltas added to k).
+// Runtime: O(n) | O(log n), O(log n) per range addition
+
+#ifndef __SegTreeLazyRmq_HPP__
+#define __SegTreeLazyRmq_HPP__
+
+
+#include <algorithm>
+
+#include "log.hpp"
+#include "segTreeRmq.hpp"
+
+
+template<typename T>
+class SegTreeLazyRMQ : public SegTreeRMQ<T>
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+    typedef typename SegTreeRMQ<T>::Node Node;
+
+
+public:
+
+    // Constructor.
+    SegTreeLazyRMQ(const std::vector<T>& data) : SegTreeRMQ<T>(data) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    // Removes all previous range additions.
+    void processData()
+    {
+        SegTreeRMQ<T>::processData();
+
+        const size_t treeSize = this->tree.size();
+
+        lazy.assign(treeSize, T());
+        sub.resize(treeSize);
+
+        for (size_t p = 0; p < treeSize; p++)
+        {
+            sub[p] = this->data[this->tree[p].minIdx];
+        }
+    }
+
+    // Adds delta to all elements in the range [i, j].
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    void rangeAdd(size_t i, size_t j, const T& delta)
+    {
+        addNode(0, i, j, delta);
+    }
+
+    // Adds deltas[r] to all elements in the range ranges[r] for each r.
+    // If there are many ranges, it is faster to first combine all of them
+    // and then to rebuild the tree once, since every range addition may touch
+    // O(log n) nodes.
+    void rangeAdd(const std::pair<size_t, size_t>* ranges, const T* deltas, size_t count)
+    {
+        const size_t n = this->data.size();
+
+        if (count * (logF(n) + 1) < n)
+        {
+            for (size_t r = 0; r < count; r++)
+            {
+                addNode(0, ranges[r].first, ranges[r].second, deltas[r]);
+            }
+
+            return;
+        }
+
+        // Combine all additions in a difference array.
+        vector<T> diff(n + 1, T());
+
+        for (size_t r = 0; r < count; r++)
+        {
+            diff[ranges[r].first] += deltas[r];
+            diff[ranges[r].second + 1] -= deltas[r];
+        }
+
+        // Push all pending additions down to the leaves. Each node is stored
+        // before its children.
+        for (size_t p = 0; p < this->tree.size(); p++)
+        {
+            const Node& node = this->tree[p];
+            if (node.left == nullptr) continue;
+
+            lazy[index(node.left)] += lazy[p];
+            if (node.right != nullptr) lazy[index(node.right)] += lazy[p];
+
+            lazy[p] = T();
+        }
+
+        // Add the combined additions to the leaves.
+        const size_t leafStart = this->tree.size() - n;
+
+        T sum = T();
+        for (size_t k = 0; k < n; k++)
+        {
+            sum += diff[k];
+            lazy[leafStart + k] += sum;
+        }
+
+        // Rebuild the tree bottom-up.
+        for (size_t p = this->tree.size(); p > 0; p--)
+        {
+            pull(p - 1);
+        }
+    }
+
+    // Repairs the tree after the value of data[i] has changed.
+    // Range additions made before remain in effect.
+    void update(size_t i)
+    {
+        updateNode(0, i);
+    }
+
+    // Repairs the tree after the values of data[] at the given indices have
+    // changed.
+    void update(const size_t* indices, size_t count)
+    {
+        for (size_t c = 0; c < count; c++)
+        {
+            updateNode(0, indices[c]);
+        }
+    }
+
+    // Returns the current value of the element at index i, i.e., data[i] plus
+    // all deltas that have been added to it.
+    T value(size_t i) const
+    {
+        T acc = T();
+        const Node* node = &this->tree[0];
+
+        while (node->left != nullptr)
+        {
+            acc += lazy[index(node)];
+            node = (i <= node->left->toIdx) ? node->left : node->right;
+        }
+
+        return acc + sub[index(node)];
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        T minVal = T();
+        size_t minIdx = -1;
+
+        queryNode(&this->tree[0], i, j, T(), minVal, minIdx);
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeLazyRMQ::operator()(r.first, r.second);
+        }
+    }
+
+    // Performs a query for each of the given ranges.
+    // The interleaved walk of SegTreeRMQ ignores pending additions; hence,
+    // use batch() instead.
+    void interleavedBatch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        SegTreeLazyRMQ::batch(ranges, count, results);
+    }
+
+
+private:
+
+    // The addition that is pending for the whole subtree of each node.
+    // For leaves, it is the total addition to the element.
+    vector<T> lazy;
+
+    // The minimum value in the subtree of each node. It includes the pending
+    // addition of the node itself, but not those of its ancestors.
+    vector<T> sub;
+
+
+    // Returns the position of the given node in tree[].
+    size_t index(const Node* node) const
+    {
+        return node - this->tree.data();
+    }
+
+    // Recomputes the minimum of node p from its children (or the data if p is
+    // a leaf). Same as minIndex(), i.e., prefers the right child if both
+    // minima are equal.
+    void pull(size_t p)
+    {
+        Node& node = this->tree[p];
+
+        if (node.left == nullptr)
+        {
+            sub[p] = this->data[node.frIdx] + lazy[p];
+            return;
+        }
+
+        size_t l = index(node.left);
+        size_t best = l;
+
+        if (node.right != nullptr)
+        {
+            size_t r = index(node.right);
+            if (!(sub[l] < sub[r])) best = r;
+        }
+
+        node.minIdx = this->tree[best].minIdx;
+        sub[p] = sub[best] + lazy[p];
+    }
+
+    // Adds delta to all elements in [i, j] that are in the subtree of node p.
+    void addNode(size_t p, size_t i, size_t j, const T& delta)
+    {
+        Node& node = this->tree[p];
+
+        if (j < node.frIdx || node.toIdx < i) return;
+
+        if (i <= node.frIdx && node.toIdx <= j)
+        {
+            // Node is fully in range.
+            lazy[p] += delta;
+            sub[p] += delta;
+            return;
+        }
+
+        addNode(index(node.left), i, j, delta);
+        if (node.right != nullptr) addNode(index(node.right), i, j, delta);
+
+        pull(p);
+    }
+
+    // Repairs the path from node p to the leaf of element i.
+    void updateNode(size_t p, size_t i)
+    {
+        const Node& node = this->tree[p];
+
+        if (node.left != nullptr)
+        {
+            const Node* next = (i <= node.left->toIdx) ? node.left : node.right;
+            updateNode(index(next), i);
+        }
+
+        pull(p);
+    }
+
+    // Searches the minimum in [i, j] within the subtree of the given node.
+    // acc is the sum of the pending additions of all ancestors.
+    // Updates minVal and minIdx if a smaller (or equal) value is found.
+    void queryNode(const Node* node, size_t i, size_t j, T acc, T& minVal, size_t& minIdx) const
+    {
+        if (j < node->frIdx || node->toIdx < i) return;
+
+        size_t p = index(node);
+
+        if (i <= node->frIdx && node->toIdx <= j)
+        {
+            // Node is fully in range.
+            T val = acc + sub[p];
+
+            if (minIdx == size_t(-1) || !(minVal < val))
+            {
+                minVal = val;
+                minIdx = node->minIdx;
+            }
+
+            return;
+        }
+
+        acc += lazy[p];
+
+        queryNode(node->left, i, j, acc, minVal, minIdx);
+        if (node->right != nullptr) queryNode(node->right, i, j, acc, minVal, minIdx);
+    }
+};
+
+#endif
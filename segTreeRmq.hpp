@@ -5,6 +5,9 @@
 #define __SegTreeRmq_HPP__
 
 
+#include <algorithm>
+
+#include "interleave.hpp"
 #include "rmq.hpp"
 
 
@@ -92,6 +95,27 @@ public:
         }
     }
 
+    // Repairs the tree after the value of data[i] has changed.
+    // The tree only stores a reference to the data. Hence, the caller changes
+    // the value and then calls this function.
+    void update(size_t i)
+    {
+        update(&i, 1);
+    }
+
+    // Repairs the tree after the values of data[] at the given indices have
+    // changed. Each node is repaired at most once, even if it is an ancestor
+    // of multiple changed elements.
+    void update(const size_t* indices, size_t count)
+    {
+        if (count == 0) return;
+
+        std::vector<size_t> sorted(indices, indices + count);
+        std::sort(sorted.begin(), sorted.end());
+
+        updateNode(&tree[0], sorted.data(), sorted.data() + sorted.size());
+    }
+
     // Performs a query on the given data and given range.
     // Returns the index of the minimum in that range.
     // Behaviour is undefined if the given range is invalid or pre-processing
@@ -180,8 +204,61 @@ public:
         return minIdx;
     }
 
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        const size_t leafStart = tree.size() - this->data.size();
 
-private:
+        for (size_t q = 0; q < count; q++)
+        {
+            // The search ends at (or close to) the leaves of i and j. Load them
+            // and their values for a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&tree[leafStart + r.first]);
+                prefetch(&tree[leafStart + r.second]);
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeRMQ<T>::operator()(r.first, r.second);
+        }
+    }
+
+    // Performs a query for each of the given ranges.
+    // Runs InterleaveWidth queries at once; see interleave.hpp and
+    // RMQ::interleavedBatch().
+    void interleavedBatch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        interleave<InterleaveWidth, Walk>
+        (
+            count,
+            [&](Walk& w, size_t q)
+            {
+                w.q = q;
+                w.i = ranges[q].first;
+                w.j = ranges[q].second;
+                w.minIdx = w.i;
+                w.pending = NoIndex;
+                w.phase = 0;
+                w.node = &tree[0];
+
+                prefetch(&this->data[w.i]);
+                prefetchChildren(w.node);
+            },
+            [&](Walk& w)
+            {
+                return walkStep(w, results);
+            }
+        );
+    }
+
+
+protected:
 
     struct Node
     {
@@ -196,8 +273,166 @@ private:
     };
 
     // Stores the nodes of the segment tree.
+    // The root is tree[0] and each node is stored before its children.
     std::vector<Node> tree;
 
+
+private:
+
+    // The number of queries interleavedBatch() runs at once.
+    static constexpr size_t InterleaveWidth = 16;
+
+    // Used similar to a null pointer.
+    static constexpr size_t NoIndex = -1;
+
+    // The state of a query in interleavedBatch(). It follows the same path
+    // as operator(), one node per step.
+    struct Walk
+    {
+        // The query and its range.
+        size_t q;
+        size_t i;
+        size_t j;
+
+        // The current minimum and an index whose value has been prefetched
+        // to compare it with the minimum in the next step.
+        size_t minIdx;
+        size_t pending;
+
+        // 0: Go down until paths to i and j split.
+        // 1: Go down left and search for i.
+        // 2: Go down right and search for j.
+        // 3: Done.
+        int phase;
+
+        // The current node (its children have been prefetched) and the node
+        // at which the search for j starts.
+        const Node* node;
+        const Node* split;
+    };
+
+
+    // Prefetches the children of the given node.
+    static void prefetchChildren(const Node* node)
+    {
+        if (node->left != nullptr) prefetch(node->left);
+        if (node->right != nullptr) prefetch(node->right);
+    }
+
+    // Runs the next step of the given query, i.e., processes one node.
+    // Returns true and writes the result if the query is done.
+    bool walkStep(Walk& w, size_t* results) const
+    {
+        if (w.pending != NoIndex)
+        {
+            w.minIdx = this->minIndex(w.minIdx, w.pending);
+            w.pending = NoIndex;
+        }
+
+        const Node* node = w.node;
+
+        if (w.phase == 0)
+        {
+            if (node->frIdx == w.i && node->toIdx == w.j)
+            {
+                // Base case.
+                results[w.q] = node->minIdx;
+                return true;
+            }
+
+            if (w.j <= node->left->toIdx)
+            {
+                // Go left.
+                w.node = node->left;
+            }
+            else if (w.i > node->left->toIdx)
+            {
+                // Go right.
+                w.node = node->right;
+            }
+            else
+            {
+                // Split paths.
+                w.split = node->right;
+                w.node = node->left;
+                w.phase = 1;
+            }
+        }
+        else if (w.phase == 1)
+        {
+            if (node->frIdx == w.i)
+            {
+                // Base case.
+                w.pending = node->minIdx;
+                w.node = w.split;
+                w.phase = 2;
+            }
+            else if (w.i <= node->left->toIdx)
+            {
+                // Get minimum from right node and go left.
+                w.pending = node->right->minIdx;
+                w.node = node->left;
+            }
+            else
+            {
+                // Go right.
+                w.node = node->right;
+            }
+        }
+        else if (w.phase == 2)
+        {
+            if (node->toIdx == w.j)
+            {
+                // Base case.
+                w.pending = node->minIdx;
+                w.phase = 3;
+            }
+            else if (w.j <= node->left->toIdx)
+            {
+                // Go left.
+                w.node = node->left;
+            }
+            else
+            {
+                // Get minimum from left node and go right.
+                w.pending = node->left->minIdx;
+                w.node = node->right;
+            }
+        }
+        else
+        {
+            results[w.q] = w.minIdx;
+            return true;
+        }
+
+        if (w.pending != NoIndex) prefetch(&this->data[w.pending]);
+        if (w.phase != 3) prefetchChildren(w.node);
+
+        return false;
+    }
+
+    // Repairs the subtree of the given node after the values of data[] at the
+    // indices in [sta, end) have changed. These indices have to be sorted and
+    // inside the range of the node.
+    void updateNode(Node* node, const size_t* sta, const size_t* end)
+    {
+        // Leaves always store their own index.
+        if (node->left == nullptr) return;
+
+        // Split the indices into those of the left and right child.
+        const size_t* mid = std::upper_bound(sta, end, node->left->toIdx);
+
+        if (sta != mid) updateNode(node->left, sta, mid);
+        if (mid != end) updateNode(node->right, mid, end);
+
+        node->minIdx = node->left->minIdx;
+
+        if (node->right != nullptr)
+        {
+            node->minIdx = this->minIndex(node->minIdx, node->right->minIdx);
+        }
+    }
+
 };
 
 #endif
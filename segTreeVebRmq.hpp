@@ -0,0 +1,310 @@
+// Represents a RMQ that uses a compact cache-oblivious segment tree to run
+// queries. Similar to SegTreeCacheRMQ, the nodes follow a van Emde Boas
+// layout. However, only nodes that represent at least one element are stored,
+// nodes refer to their children via indices instead of pointers, and the range
+// of each node is computed while walking down instead of being stored.
+// Runtime: O(n) | O(log n)
+
+#ifndef __SegTreeVebRmq_HPP__
+#define __SegTreeVebRmq_HPP__
+
+
+#include <algorithm>
+#include <limits>
+
+#include "log.hpp"
+#include "rmq.hpp"
+
+
+template
+<
+    typename T,
+    // The integer type used to store indices in the tree. It has to be able
+    // to represent all indices of the data and all nodes (about 2n).
+    typename Index = uint32_t
+>
+class SegTreeVebRMQ : public RMQ<T>
+{
+    // Used similar to a null pointer.
+    static constexpr Index InvalidIndex = std::numeric_limits<Index>::max();
+
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+    // A node of the tree.
+    struct Node
+    {
+        // The positions of the children in tree[].
+        Index left  = InvalidIndex;
+        Index right = InvalidIndex;
+
+        Index minIdx = InvalidIndex;
+    };
+
+
+public:
+
+    // Constructor.
+    SegTreeVebRMQ(const std::vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        n = this->data.size();
+
+        // Height is ceil(log n) + 1.
+        height = logC(n) + 1;
+
+        // Determine the number of nodes. Layer d (the root is in layer 0) has
+        // one node for each 2^(height - 1 - d) elements.
+        size_t treeSize = 0;
+        for (size_t d = 0; d < height; d++)
+        {
+            size_t span = size_t(1) << (height - 1 - d);
+            treeSize += (n + span - 1) / span;
+        }
+
+        tree.clear();
+        tree.reserve(treeSize);
+
+        // Positions of the leaves in tree[].
+        vector<Index> leafPositions;
+        leafPositions.reserve(n);
+
+        {
+            vector<Index> leafStack;
+            leafStack.reserve(size_t(1) << (height >> 1));
+
+            // Build tree structure recursively. The root has heap ID 1.
+            buildTree(1, height, leafPositions, leafStack);
+        }
+
+        // Initialise leaves.
+        for (size_t i = 0; i < n; i++)
+        {
+            tree[leafPositions[i]].minIdx = Index(i);
+        }
+
+        // Process tree bottom up. Each node is stored before its children.
+        for (size_t p = tree.size() - 1; p < tree.size(); p--)
+        {
+            Node& node = tree[p];
+
+            // Skip leaves.
+            if (node.left == InvalidIndex) continue;
+
+            node.minIdx = tree[node.left].minIdx;
+
+            if (node.right != InvalidIndex)
+            {
+                node.minIdx = Index(this->minIndex(node.minIdx, tree[node.right].minIdx));
+            }
+        }
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        if (i == j) return i;
+
+        size_t minIdx = i;
+
+        // The current node represents the elements fr, ..., fr + span - 1.
+        const Node* node = &tree[0];
+        size_t fr = 0;
+        size_t span = size_t(1) << (height - 1);
+
+        // Go down until paths to i and j split.
+        for (;;)
+        {
+            span >>= 1;
+            size_t leftTo = fr + span - 1;
+
+            if (j <= leftTo)
+            {
+                // Go left.
+                node = &tree[node->left];
+            }
+            else if (i > leftTo)
+            {
+                // Go right.
+                node = &tree[node->right];
+                fr += span;
+            }
+            else
+            {
+                // Split paths.
+                break;
+            }
+        }
+
+        // Go down left and search for i.
+        for (size_t iFr = fr, iSpan = span, iPos = node->left; ; )
+        {
+            const Node& iNode = tree[iPos];
+
+            if (iFr == i)
+            {
+                // Base case: the whole subtree is in range.
+                minIdx = this->minIndex(minIdx, iNode.minIdx);
+                break;
+            }
+
+            iSpan >>= 1;
+
+            if (i < iFr + iSpan)
+            {
+                // Get minimum from right node ...
+                minIdx = this->minIndex(minIdx, tree[iNode.right].minIdx);
+
+                // ... and go left.
+                iPos = iNode.left;
+            }
+            else
+            {
+                // Go right.
+                iPos = iNode.right;
+                iFr += iSpan;
+            }
+        }
+
+        // Go down right and search for j.
+        for (size_t jFr = fr + span, jSpan = span, jPos = node->right; ; )
+        {
+            const Node& jNode = tree[jPos];
+
+            if (j + 1 == std::min(jFr + jSpan, n))
+            {
+                // Base case: the whole subtree is in range.
+                minIdx = this->minIndex(minIdx, jNode.minIdx);
+                break;
+            }
+
+            jSpan >>= 1;
+
+            if (j < jFr + jSpan)
+            {
+                // Go left.
+                jPos = jNode.left;
+            }
+            else
+            {
+                // Get minimum from left node ...
+                minIdx = this->minIndex(minIdx, tree[jNode.left].minIdx);
+
+                // ... and go right.
+                jPos = jNode.right;
+                jFr += jSpan;
+            }
+        }
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the values of the range's endpoints for a later query into
+            // the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeVebRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The size of the data.
+    size_t n = 0;
+
+    // The number of layers of the tree.
+    size_t height = 0;
+
+    // Stores the nodes of the segment tree.
+    vector<Node> tree;
+
+
+    // Determines whether the node with the given heap ID represents at least
+    // one element. Node x is in layer d = floor(log x) and represents the
+    // elements starting at (x - 2^d) * 2^(height - 1 - d).
+    bool exists(size_t heapId) const
+    {
+        size_t d = logF(heapId);
+        return ((heapId - (size_t(1) << d)) << (height - 1 - d)) < n;
+    }
+
+    // Recursively builds the subtree of the node with the given heap ID and
+    // the given number of layers. Appends its nodes to tree[] in van Emde Boas
+    // order and the positions of its leaves (from left to right) to
+    // leafPositions.
+    void buildTree(size_t heapId, size_t layers, vector<Index>& leafPositions, vector<Index>& leafStack)
+    {
+        if (layers == 1)
+        {
+            leafPositions.push_back(Index(tree.size()));
+            tree.push_back(Node());
+            return;
+        }
+
+
+        size_t topHeight = layers >> 1;
+        size_t botHeight = (layers + 1) >> 1;
+
+        // Build upper part
+        size_t leafSta = leafPositions.size();
+        buildTree(heapId, topHeight, leafPositions, leafStack);
+        size_t leafEnd = leafPositions.size();
+
+        // Move top-leaves onto stack. Only a prefix of them exists; they have
+        // the heap IDs firstLeaf, firstLeaf + 1, ...
+        size_t firstLeaf = heapId << (topHeight - 1);
+        size_t topLeaves = leafEnd - leafSta;
+
+        for (size_t ptr = leafSta; ptr < leafEnd; ptr++)
+        {
+            leafStack.push_back(leafPositions[ptr]);
+        }
+
+        // Remove top-leaves from list.
+        leafPositions.resize(leafSta);
+
+
+        // Build lower parts.
+        size_t stackSta = leafStack.size() - topLeaves;
+
+        for (size_t k = 0; k < topLeaves; k++)
+        {
+            size_t pPos = leafStack[stackSta + k];
+            size_t lId = (firstLeaf + k) << 1;
+
+            tree[pPos].left = Index(tree.size());
+            buildTree(lId, botHeight, leafPositions, leafStack);
+
+            if (exists(lId + 1))
+            {
+                tree[pPos].right = Index(tree.size());
+                buildTree(lId + 1, botHeight, leafPositions, leafStack);
+            }
+        }
+
+        // Remove top leaves from stack.
+        leafStack.resize(stackSta);
+    }
+};
+
+#endif
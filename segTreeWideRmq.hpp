@@ -0,0 +1,199 @@
+// Represents a RMQ that uses a B-ary segment tree to run queries.
+// Each node has B children. The minima of the children of a node are stored
+// next to each other in one block; for B = 16 and 32-bit values, such a block
+// is exactly one cache line. Queries scan at most two partial blocks per
+// level using vector instructions (see simdArgmin()). Hence, a query reads
+// O(log_B n) blocks instead of O(log n) nodes.
+// Runtime: O(n) | O(B log_B n)
+
+#ifndef __SegTreeWideRmq_HPP__
+#define __SegTreeWideRmq_HPP__
+
+
+#include <algorithm>
+
+#include "aligned.hpp"
+#include "rmq.hpp"
+#include "simdArgmin.hpp"
+
+
+template
+<
+    typename T,
+    // The number of children of each node.
+    size_t B = 16,
+    // The integer type used to store indices in the tree. It has to be able
+    // to represent all indices of the data, e.g., uint32_t if n < 2^32.
+    typename Index = size_t
+>
+class SegTreeWideRMQ : public RMQ<T>
+{
+    static_assert(B >= 2, "Nodes need at least two children.");
+
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    SegTreeWideRMQ(const std::vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        const vector<T>& data = this->data;
+        const size_t n = data.size();
+
+        // --- Determine size of each layer. ---
+
+        // Layer 0 is the data itself and not stored. Layer l > 0 has one
+        // entry per block of B entries in layer l - 1. Each layer starts at a
+        // multiple of B to align its blocks.
+
+        layerSize.clear();
+        layerOffset.clear();
+
+        layerSize.push_back(n);
+        layerOffset.push_back(0);
+
+        size_t total = 0;
+        for (size_t size = n; size > B; )
+        {
+            size = (size + B - 1) / B;
+
+            layerSize.push_back(size);
+            layerOffset.push_back(total);
+
+            total += (size + B - 1) / B * B;
+        }
+
+        vals.resize(total);
+        idxs.resize(total);
+
+
+        // --- Build layers bottom-up. ---
+
+        for (size_t l = 1; l < layerSize.size(); l++)
+        {
+            const size_t prvSize = layerSize[l - 1];
+            const T* prvVals = layerVals(l - 1);
+
+            T* curVals = vals.data() + layerOffset[l];
+            Index* curIdxs = idxs.data() + layerOffset[l];
+
+            for (size_t k = 0, sta = 0; sta < prvSize; k++, sta += B)
+            {
+                size_t len = std::min(B, prvSize - sta);
+                size_t pos = sta + simdArgmin(prvVals + sta, len);
+
+                curVals[k] = prvVals[pos];
+                curIdxs[k] = Index(dataIndex(l - 1, pos));
+            }
+        }
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        T minVal = T();
+        size_t minIdx = -1;
+
+        for (size_t l = 0; ; l++)
+        {
+            // Small range? Then scan it completely.
+            if (j - i < 2 * B)
+            {
+                scan(l, i, j, minVal, minIdx);
+                break;
+            }
+
+            // Scan the parts of the blocks of i and j that are in range. The
+            // blocks in between are fully in range and represented by the
+            // entries i / B + 1, ..., j / B - 1 in the next layer. Since
+            // j - i >= 2B, there is at least one such block.
+            scan(l, i, i - i % B + B - 1, minVal, minIdx);
+            scan(l, j - j % B, j, minVal, minIdx);
+
+            i = i / B + 1;
+            j = j / B - 1;
+        }
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the blocks of the endpoints of a later query in the two
+            // lowest stored layers into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&this->data[r.first]);
+                prefetch(&this->data[r.second]);
+
+                for (size_t l = 1, i = r.first / B, j = r.second / B; l < layerSize.size() && l < 3; l++, i /= B, j /= B)
+                {
+                    prefetch(layerVals(l) + i);
+                    prefetch(layerVals(l) + j);
+                }
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SegTreeWideRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The number of entries in each layer. Layer 0 is the data.
+    vector<size_t> layerSize;
+
+    // Where each layer (except layer 0) starts in vals[] and idxs[].
+    vector<size_t> layerOffset;
+
+    // The minimum of each block of the layer below, for all layers l > 0.
+    AlignedVector<T> vals;
+
+    // The index in data[] of each minimum in vals[].
+    AlignedVector<Index> idxs;
+
+
+    // Returns the values of layer l.
+    const T* layerVals(size_t l) const
+    {
+        return l == 0 ? this->data.data() : vals.data() + layerOffset[l];
+    }
+
+    // Returns the index in data[] of the entry at position p in layer l.
+    size_t dataIndex(size_t l, size_t p) const
+    {
+        return l == 0 ? p : idxs[layerOffset[l] + p];
+    }
+
+    // Searches the minimum of the entries a, ..., b in layer l.
+    // Updates minVal and minIdx if it is smaller than the current minimum.
+    void scan(size_t l, size_t a, size_t b, T& minVal, size_t& minIdx) const
+    {
+        const T* v = layerVals(l);
+        size_t pos = a + simdArgmin(v + a, b - a + 1);
+
+        if (minIdx == size_t(-1) || v[pos] < minVal)
+        {
+            minVal = v[pos];
+            minIdx = dataIndex(l, pos);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,233 @@
+// Implements functions to find the position of the minimum in an array.
+// For signed integers (8 to 64 bits), float, and double, the search uses
+// AVX-512 or AVX2 if the CPU supports it. The instruction set is determined at
+// runtime. All other types and CPUs use a scalar loop.
+// If the minimum occurs multiple times, the functions return its first
+// position.
+
+#ifndef __SimdArgmin_HPP__
+#define __SimdArgmin_HPP__
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Uses a scalar loop. Requires n > 0.
+template<typename T>
+inline size_t argminScalar(const T* a, size_t n)
+{
+    size_t minIdx = 0;
+
+    for (size_t k = 1; k < n; k++)
+    {
+        if (a[k] < a[minIdx]) minIdx = k;
+    }
+
+    return minIdx;
+}
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+// Returns the first lane of the given comparison result that is set, or the
+// number of lanes if none is set. Each lane is either all zeros or all ones.
+template<typename T, size_t W, typename Mask>
+__attribute__((always_inline))
+inline size_t firstLane(const Mask& eq)
+{
+    constexpr size_t LanesPerWord = sizeof(uint64_t) / sizeof(T);
+
+    uint64_t words[W / sizeof(uint64_t)];
+    memcpy(words, &eq, W);
+
+    for (size_t w = 0; w < W / sizeof(uint64_t); w++)
+    {
+        if (words[w] != 0) return w * LanesPerWord + __builtin_ctzll(words[w]) / (8 * sizeof(T));
+    }
+
+    return W / sizeof(T);
+}
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Uses vectors with a size of W bytes. Requires n >= W / sizeof(T), i.e., at
+// least one full vector. Ranges that are not a multiple of the vector size
+// end with a vector that overlaps the previous one.
+// Always inlined so that it is compiled with the instruction set of the
+// calling function.
+template<typename T, size_t W>
+__attribute__((always_inline))
+inline size_t argminVector(const T* a, size_t n)
+{
+    typedef T Vec __attribute__((vector_size(W)));
+
+    // Number of elements per vector.
+    constexpr size_t L = W / sizeof(T);
+
+
+    // --- Determine minimum. ---
+
+    // Four independent minima hide the latency of the comparisons.
+    Vec min0, min1, min2, min3;
+    memcpy(&min0, a, W);
+    min1 = min0;
+    min2 = min0;
+    min3 = min0;
+
+    size_t k = L;
+    for (; k + 4 * L <= n; k += 4 * L)
+    {
+        Vec x0, x1, x2, x3;
+        memcpy(&x0, a + k, W);
+        memcpy(&x1, a + k + L, W);
+        memcpy(&x2, a + k + 2 * L, W);
+        memcpy(&x3, a + k + 3 * L, W);
+
+        min0 = x0 < min0 ? x0 : min0;
+        min1 = x1 < min1 ? x1 : min1;
+        min2 = x2 < min2 ? x2 : min2;
+        min3 = x3 < min3 ? x3 : min3;
+    }
+
+    for (; k + L <= n; k += L)
+    {
+        Vec x;
+        memcpy(&x, a + k, W);
+        min0 = x < min0 ? x : min0;
+    }
+
+    // The last vector may overlap with the previous one.
+    {
+        Vec x;
+        memcpy(&x, a + n - L, W);
+        min1 = x < min1 ? x : min1;
+    }
+
+    min0 = min1 < min0 ? min1 : min0;
+    min2 = min3 < min2 ? min3 : min2;
+    Vec minVec = min2 < min0 ? min2 : min0;
+
+    // Halve the minima down to 16 bytes, then finish with a scalar loop.
+    T lanes[L];
+    memcpy(lanes, &minVec, W);
+
+    for (size_t h = L / 2; h * sizeof(T) >= 16; h /= 2)
+    {
+        for (size_t l = 0; l < h; l++)
+        {
+            lanes[l] = lanes[l + h] < lanes[l] ? lanes[l + h] : lanes[l];
+        }
+    }
+
+    T minVal = lanes[0];
+    for (size_t l = 1; l < L && l * sizeof(T) < 16; l++)
+    {
+        if (lanes[l] < minVal) minVal = lanes[l];
+    }
+
+
+    // --- Find first position of minimum. ---
+
+    const Vec minAll = Vec{} + minVal;
+
+    for (k = 0; k + L <= n; k += L)
+    {
+        Vec x;
+        memcpy(&x, a + k, W);
+
+        size_t l = firstLane<T, W>(x == minAll);
+        if (l < L) return k + l;
+    }
+
+    // The last vector may overlap with the previous one. Its lanes before k
+    // did not match, so a match is at position k or later.
+    if (k < n)
+    {
+        Vec x;
+        memcpy(&x, a + n - L, W);
+
+        size_t l = firstLane<T, W>(x == minAll);
+        if (l < L) return n - L + l;
+    }
+
+    // No element equals the minimum, which happens if it is NaN.
+    return argminScalar(a, n);
+}
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Requires AVX2 and n > 0. Uses the widest vectors that fit into the range.
+template<typename T>
+__attribute__((target("avx2")))
+size_t argminAvx2(const T* a, size_t n)
+{
+    if (n >= 32 / sizeof(T)) return argminVector<T, 32>(a, n);
+    if (n >= 16 / sizeof(T)) return argminVector<T, 16>(a, n);
+    return argminScalar(a, n);
+}
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Requires AVX-512 (F and BW) and n > 0. Uses the widest vectors that fit
+// into the range.
+template<typename T>
+__attribute__((target("avx512f,avx512bw")))
+size_t argminAvx512(const T* a, size_t n)
+{
+    if (n >= 64 / sizeof(T)) return argminVector<T, 64>(a, n);
+    if (n >= 32 / sizeof(T)) return argminVector<T, 32>(a, n);
+    if (n >= 16 / sizeof(T)) return argminVector<T, 16>(a, n);
+    return argminScalar(a, n);
+}
+
+// Determines the best instruction set supported by the CPU.
+// 2: AVX-512, 1: AVX2, 0: neither.
+inline int simdLevel()
+{
+    static const int level =
+        __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") ? 2 :
+        __builtin_cpu_supports("avx2") ? 1 :
+        0;
+
+    return level;
+}
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Selects the best implementation available. Requires n > 0.
+template<typename T>
+inline size_t argminDispatch(const T* a, size_t n)
+{
+    switch (simdLevel())
+    {
+        case 2:  return argminAvx512(a, n);
+        case 1:  return argminAvx2(a, n);
+        default: return argminScalar(a, n);
+    }
+}
+
+#else
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// No vector instructions are available. Requires n > 0.
+template<typename T>
+inline size_t argminDispatch(const T* a, size_t n)
+{
+    return argminScalar(a, n);
+}
+
+#endif
+
+
+// Returns the position of the first minimum in a[0], ..., a[n - 1].
+// Requires n > 0.
+template<typename T>
+inline size_t simdArgmin(const T* a, size_t n) { return argminScalar(a, n); }
+
+inline size_t simdArgmin(const int8_t*  a, size_t n) { return argminDispatch(a, n); }
+inline size_t simdArgmin(const int16_t* a, size_t n) { return argminDispatch(a, n); }
+inline size_t simdArgmin(const int32_t* a, size_t n) { return argminDispatch(a, n); }
+inline size_t simdArgmin(const int64_t* a, size_t n) { return argminDispatch(a, n); }
+inline size_t simdArgmin(const float*   a, size_t n) { return argminDispatch(a, n); }
+inline size_t simdArgmin(const double*  a, size_t n) { return argminDispatch(a, n); }
+
+#endif
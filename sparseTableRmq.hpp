@@ -1,5 +1,4 @@
-// Represents a RMQ without pre-processing by simply iterating over the given
-// range.
+// Represents a RMQ that uses a sparse table to run queries.
 // Runtime: O(n log n) | O(1)
 
 #ifndef __SparseTableRmq_HPP__
@@ -7,17 +6,45 @@
 
 
 #include <algorithm>
+#include <type_traits>
 
+#include "aligned.hpp"
 #include "log.hpp"
+#include "parallel.hpp"
 #include "rmq.hpp"
 
 
-template<typename T>
+template
+<
+    typename T,
+    // The integer type used to store indices in the table. It has to be able
+    // to represent all indices of the data, e.g., uint32_t if n < 2^32.
+    typename Index = size_t,
+    // Whether the table stores the value of each minimum next to its index.
+    // Queries then do not need to look up values in the data.
+    bool StoreValues = false
+>
 class SparseTableRMQ : public RMQ<T>
 {
     // Shortcut to avoid the need for "std::".
     template<typename X> using vector = std::vector<X>;
 
+    // An entry of the table that only stores the index of a minimum.
+    struct IndexEntry
+    {
+        Index idx;
+    };
+
+    // An entry of the table that stores the index and value of a minimum.
+    struct ValueEntry
+    {
+        T val;
+        Index idx;
+    };
+
+    typedef typename std::conditional<StoreValues, ValueEntry, IndexEntry>::type Entry;
+
+
 public:
 
     // Constructor.
@@ -28,41 +55,76 @@ public:
     void processData()
     {
         const vector<T>& data = this-> data;
-        const size_t n = data.size();
+        n = data.size();
 
         // Height of the table is floor(log n) + 1
         size_t tableHeight = logF(n) + 1;
 
         // We divert from the paper and have the height as first index and
-        // length as second. That way, we always use the same vector instead
-        // of two different ones; thereby improving caching and improving the
+        // length as second. That way, we always use the same row instead of
+        // two different ones; thereby improving caching and improving the
         // runtime slightly.
-        M.resize(tableHeight, vector<size_t>(n));
+        // Furthermore, all rows are stored in one contiguous array. Row 0
+        // only contains the indices 0, ..., n - 1 and is not stored at all.
+        // Row k only stores the first n - 2^k + 1 entries since queries never
+        // use the remaining ones.
+        table.clear();
+        table.resize(rowOffset(tableHeight));
+
+        if (tableHeight < 2) return;
 
-        for (size_t i = 0; i < n; i++)
+        // Each row only depends on the row below. Hence, the entries of a
+        // row are computed in parallel.
+
+        // Row 1 compares neighbours.
         {
-            M[0][i] = i;
+            Entry* row = table.data();
+
+            parallelFor(0, n - 1, threadCount, ChunkSize, [&](size_t sta, size_t end)
+            {
+                for (size_t i = sta; i < end; i++)
+                {
+                    Entry lEntry, rEntry;
+                    setEntry(lEntry, i);
+                    setEntry(rEntry, i + 1);
+
+                    row[i] = minEntry(lEntry, rEntry);
+                }
+            });
         }
 
-        for (size_t j = 1; j < tableHeight; j++)
+        for (size_t k = 2; k < tableHeight; k++)
         {
-            for (size_t i = 0; i < n; i++)
-            {
-                // Compare the two ranges below:
-                // M[j - 1, i] and M[j - 1, i + 2^{j - 1} - 1]
+            // Compare the two ranges below:
+            // M[k - 1, i] and M[k - 1, i + 2^{k - 1}]
 
-                // Check that right index is not out of range.
-                size_t lIdx = i;
-                size_t rIdx = std::min(n - 1, i + (1 << (j - 1)));
+            const Entry* prvRow = table.data() + rowOffset(k - 1);
+            Entry* curRow = table.data() + rowOffset(k);
 
-                size_t lMin = M[j - 1][lIdx];
-                size_t rMin = M[j - 1][rIdx];
+            size_t half = size_t(1) << (k - 1);
+            size_t len  = n - (size_t(1) << k) + 1;
 
-                M[j][i] = this->minIndex(lMin, rMin);
-            }
+            parallelFor(0, len, threadCount, ChunkSize, [&](size_t sta, size_t end)
+            {
+                // Branch-free to allow the compiler to vectorise the loop.
+                for (size_t i = sta; i < end; i++)
+                {
+                    const Entry& lEntry = prvRow[i];
+                    const Entry& rEntry = prvRow[i + half];
+
+                    curRow[i] = value(lEntry) < value(rEntry) ? lEntry : rEntry;
+                }
+            });
         }
     }
 
+    // Sets how many threads the pre-processing uses.
+    // By default, it uses one thread per core.
+    void setThreadCount(size_t count)
+    {
+        threadCount = std::max<size_t>(count, 1);
+    }
+
     // Performs a query on the given data and given range.
     // Returns the index of the minimum in that range.
     // Behaviour is undefined if the given range is invalid or pre-processing
@@ -72,20 +134,108 @@ public:
         // k = floor(log (j − i))
         size_t k = logF(j - i);
 
+        // Row 0 is not stored.
+        if (k == 0) return this->minIndex(i, j);
+
         // M[k, i]
         // M[k, j − 2^k + 1]
 
-        size_t min1 = M[k][i];
-        size_t min2 = M[k][j - (1 << k) + 1];
+        const Entry* row = table.data() + rowOffset(k);
+
+        const Entry& min1 = row[i];
+        const Entry& min2 = row[j - (size_t(1) << k) + 1];
+
+        return minEntry(min1, min2).idx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the table entries of a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+                size_t k = logF(r.second - r.first);
+
+                if (k > 0)
+                {
+                    const Entry* row = table.data() + rowOffset(k);
+
+                    prefetch(&row[r.first]);
+                    prefetch(&row[r.second - (size_t(1) << k) + 1]);
+                }
+            }
 
-        return this->minIndex(min1, min2);
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SparseTableRMQ::operator()(r.first, r.second);
+        }
     }
 
 
 private:
 
+    // The number of entries a thread computes at once when pre-processing.
+    static constexpr size_t ChunkSize = 1 << 16;
+
+
+    // The size of the data.
+    size_t n = 0;
+
+    // The number of threads used for pre-processing.
+    size_t threadCount = defaultThreadCount();
+
     // Table with minimums in various ranges.
-    vector<vector<size_t>> M;
+    // Contains the rows 1, 2, ... one after another.
+    AlignedVector<Entry> table;
+
+
+    // Determines where row k (k >= 1) starts in the table.
+    // Row l has n - 2^l + 1 entries. Hence, the first k - 1 rows have
+    //     sum_{l = 1}^{k - 1} (n - 2^l + 1) = (k - 1)(n + 1) - 2^k + 2
+    // entries in total.
+    size_t rowOffset(size_t k) const
+    {
+        return (k - 1) * (n + 1) - (size_t(1) << k) + 2;
+    }
+
+
+    // Initialises an entry for a range containing only the element at index i.
+    void setEntry(IndexEntry& entry, size_t i) const
+    {
+        entry.idx = Index(i);
+    }
+
+    // Initialises an entry for a range containing only the element at index i.
+    void setEntry(ValueEntry& entry, size_t i) const
+    {
+        entry.val = this->data[i];
+        entry.idx = Index(i);
+    }
+
+
+    // Returns the value of the minimum an entry represents.
+    const T& value(const IndexEntry& entry) const
+    {
+        return this->data[entry.idx];
+    }
+
+    // Returns the value of the minimum an entry represents.
+    const T& value(const ValueEntry& entry) const
+    {
+        return entry.val;
+    }
+
+
+    // Determines which of these entries represents the smaller value.
+    // Same as minIndex(), i.e., returns the second entry if both are equal.
+    const Entry& minEntry(const Entry& lEntry, const Entry& rEntry) const
+    {
+        if (value(lEntry) < value(rEntry)) return lEntry;
+        else return rEntry;
+    }
 };
 
 #endif
@@ -0,0 +1,241 @@
+// Represents a RMQ that uses a sqrt tree to run queries.
+// The tree has a few layers. Each layer splits the data into segments of
+// 2^s elements and each segment into blocks of about 2^(s / 2) elements. It
+// stores the minimum of each prefix and each suffix of each block, and for
+// each segment the minimum of each range of its blocks. A query [i, j] uses
+// the layer in which i and j are in the same segment but in different blocks:
+// the answer is the minimum of the suffix of i's block, the blocks in between,
+// and the prefix of j's block. The next layer splits each block of the current
+// layer into segments; hence, s halves from layer to layer. Very short ranges
+// are scanned instead of using the small layers.
+// Runtime: O(n log log n) | O(1)
+
+#ifndef __SqrtTreeRmq_HPP__
+#define __SqrtTreeRmq_HPP__
+
+
+#include <algorithm>
+#include <cstdint>
+
+#include "log.hpp"
+#include "rmq.hpp"
+
+
+template
+<
+    typename T,
+    // The integer type used to store indices in the tree. It has to be able
+    // to represent all indices of the data, e.g., uint32_t if n < 2^32.
+    typename Index = uint32_t
+>
+class SqrtTreeRMQ : public RMQ<T>
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+    // A layer of the tree.
+    struct Layer
+    {
+        // Segments have 2^segBits elements, blocks have 2^blkBits elements.
+        size_t segBits;
+        size_t blkBits;
+
+        // The minimum from the start of each element's block to the element.
+        vector<Index> prefix;
+
+        // The minimum from each element to the end of its block.
+        vector<Index> suffix;
+
+        // The minimum of the blocks a, ..., b (global block numbers in the
+        // same segment) is stored at between[a * c + b % c], where c is the
+        // number of blocks in a segment. Each segment thus uses c * c entries.
+        vector<Index> between;
+    };
+
+
+public:
+
+    // Constructor.
+    SqrtTreeRMQ(const std::vector<T>& data) : RMQ<T>(data) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        const size_t n = this->data.size();
+
+        // Indices of the data have at most logC(n) bits. Let h be the number
+        // of bits of i XOR j, i.e., i and j are equal except for their lowest
+        // h bits. Then the layer with blkBits < h <= segBits answers [i, j].
+        const size_t bits = logC(n);
+
+        layers.clear();
+        layerOf.assign(bits + 1, 0);
+
+        for (size_t segBits = bits; segBits > ScanBits; segBits = (segBits + 1) >> 1)
+        {
+            size_t blkBits = (segBits + 1) >> 1;
+
+            for (size_t h = blkBits + 1; h <= segBits; h++)
+            {
+                layerOf[h] = layers.size();
+            }
+
+            layers.emplace_back();
+            buildLayer(layers.back(), segBits, blkBits);
+        }
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        const size_t h = highBits(i, j);
+
+        // Short range? Then scan it.
+        if (h <= ScanBits)
+        {
+            size_t minIdx = j;
+            for (size_t k = i; k < j; k++) minIdx = this->minIndex(k, minIdx);
+
+            return minIdx;
+        }
+
+        const Layer& layer = layers[layerOf[h]];
+
+        size_t minIdx = this->minIndex(layer.suffix[i], layer.prefix[j]);
+
+        // Blocks between i and j.
+        size_t a = (i >> layer.blkBits) + 1;
+        size_t b = (j >> layer.blkBits) - 1;
+
+        if (a <= b)
+        {
+            minIdx = this->minIndex(minIdx, layer.between[betweenPos(layer, a, b)]);
+        }
+
+        return minIdx;
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the suffix and prefix entries of a later query into the
+            // cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+                size_t h = highBits(r.first, r.second);
+
+                if (h > ScanBits)
+                {
+                    const Layer& layer = layers[layerOf[h]];
+
+                    prefetch(&layer.suffix[r.first]);
+                    prefetch(&layer.prefix[r.second]);
+                }
+                else
+                {
+                    prefetch(&this->data[r.first]);
+                }
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SqrtTreeRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // Ranges [i, j] in which i and j only differ in their lowest ScanBits bits
+    // are scanned.
+    static constexpr size_t ScanBits = 3;
+
+
+    // The layers of the tree, starting with the largest segments.
+    vector<Layer> layers;
+
+    // The layer to use for each value of highBits().
+    vector<size_t> layerOf;
+
+
+    // Returns the number of bits of i XOR j.
+    static size_t highBits(size_t i, size_t j)
+    {
+        return i == j ? 0 : logF(i ^ j) + 1;
+    }
+
+    // Returns the position in between[] of the range of blocks a, ..., b.
+    // Both blocks have to be in the same segment.
+    static size_t betweenPos(const Layer& layer, size_t a, size_t b)
+    {
+        const size_t cntBits = layer.segBits - layer.blkBits;
+        const size_t cntMask = (size_t(1) << cntBits) - 1;
+
+        return (a << cntBits) | (b & cntMask);
+    }
+
+    // Computes the minima of the given layer.
+    void buildLayer(Layer& layer, size_t segBits, size_t blkBits)
+    {
+        const vector<T>& data = this->data;
+        const size_t n = data.size();
+
+        layer.segBits = segBits;
+        layer.blkBits = blkBits;
+
+        const size_t blkSize = size_t(1) << blkBits;
+        const size_t cntBits = segBits - blkBits;
+        const size_t blocks  = ((n - 1) >> blkBits) + 1;
+
+        // Minima within blocks.
+        layer.prefix.resize(n);
+        layer.suffix.resize(n);
+
+        for (size_t sta = 0; sta < n; sta += blkSize)
+        {
+            size_t end = std::min(sta + blkSize, n);
+
+            layer.prefix[sta] = Index(sta);
+            for (size_t k = sta + 1; k < end; k++)
+            {
+                size_t prv = layer.prefix[k - 1];
+                layer.prefix[k] = Index(data[k] < data[prv] ? k : prv);
+            }
+
+            layer.suffix[end - 1] = Index(end - 1);
+            for (size_t k = end - 1; k > sta; k--)
+            {
+                size_t nxt = layer.suffix[k];
+                layer.suffix[k - 1] = Index(data[k - 1] <= data[nxt] ? k - 1 : nxt);
+            }
+        }
+
+        // Minima between blocks. The minimum of a whole block is the minimum
+        // of the suffix that starts with its first element.
+        const size_t segments = ((n - 1) >> segBits) + 1;
+        layer.between.resize(segments << (2 * cntBits));
+
+        for (size_t a = 0; a < blocks; a++)
+        {
+            size_t minIdx = layer.suffix[a << blkBits];
+
+            // Blocks a, ..., b with b in the same segment as a.
+            size_t segEnd = std::min(((a >> cntBits) + 1) << cntBits, blocks);
+
+            for (size_t b = a; b < segEnd; b++)
+            {
+                minIdx = this->minIndex(minIdx, layer.suffix[b << blkBits]);
+                layer.between[betweenPos(layer, a, b)] = Index(minIdx);
+            }
+        }
+    }
+};
+
+#endif
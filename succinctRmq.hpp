@@ -0,0 +1,368 @@
+// Represents a RMQ that uses a succinct encoding of the Cartesian tree to run
+// queries. The tree is stored as a sequence of about 2n parentheses (bits),
+// and queries only use that sequence and small directories on top of it; they
+// do not access the data.
+// Runtime: O(n) | O(1) (expected; selecting a bit may need a short search)
+
+// The sequence is created while scanning the data from left to right with a
+// stack that contains the minima of all suffixes of the scanned part. For each
+// element k, it contains one ')' for each element removed from the stack
+// before k is added, followed by one '(' when k is added. The excess (number
+// of '(' minus number of ')') after the '(' of k is the size of the stack after
+// adding k.
+// Consider a query [i, j] and let m be the minimum in that range. Then m is the
+// lowest element on the stack after adding j that is not left of i. If m = i,
+// the excess between the '(' of i and the '(' of j never drops below its value
+// at the '(' of i. Otherwise, the smallest excess in that range is reached
+// last right before the '(' of m.
+
+#ifndef __SuccinctRmq_HPP__
+#define __SuccinctRmq_HPP__
+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "bitRmq.hpp"
+#include "rmq.hpp"
+#include "sparseTableRmq.hpp"
+
+
+template<typename T>
+class SuccinctRMQ : public RMQ<T>
+{
+    // Shortcut to avoid the need for "std::".
+    template<typename X> using vector = std::vector<X>;
+
+
+public:
+
+    // Constructor.
+    SuccinctRMQ(const std::vector<T>& data) : RMQ<T>(data), superRmq(superKeys) { /* Nothing. */ }
+
+
+    // Pre-processes the data to allow queries.
+    void processData()
+    {
+        const vector<T>& data = this->data;
+        const size_t     n    = this->data.size();
+
+
+        // --- Create parentheses. ---
+
+        words.clear();
+        words.reserve((2 * n + 63) / 64 + 1);
+
+        size_t bitCount = 0;
+        uint64_t word = 0;
+
+        // Appends a bit to the sequence.
+        auto append = [&](bool bit)
+        {
+            word |= uint64_t(bit) << (bitCount & 63);
+            bitCount++;
+
+            if ((bitCount & 63) == 0)
+            {
+                words.push_back(word);
+                word = 0;
+            }
+        };
+
+        {
+            vector<size_t> stack;
+
+            for (size_t k = 0; k < n; k++)
+            {
+                while (stack.size() > 0 && data[k] < data[stack.back()])
+                {
+                    stack.pop_back();
+                    append(false);
+                }
+
+                stack.push_back(k);
+                append(true);
+            }
+        }
+
+        // Fill the last word with '('. They never form a minimum.
+        if ((bitCount & 63) != 0)
+        {
+            words.push_back(word | (~uint64_t(0) << (bitCount & 63)));
+        }
+
+        // Allow to always access a word after the last one.
+        words.push_back(~uint64_t(0));
+
+
+        // --- Build directories. ---
+
+        const size_t wordCount = words.size();
+        const size_t superCount = (wordCount + SuperWords - 1) / SuperWords;
+
+        superRank.resize(superCount);
+        wordRank.resize(wordCount);
+        wordMin.resize(wordCount);
+        superKeys.resize(superCount);
+        selectHint.clear();
+
+        size_t ones = 0;
+
+        for (size_t s = 0; s < superCount; s++)
+        {
+            superRank[s] = ones;
+
+            int64_t superMin = std::numeric_limits<int64_t>::max();
+
+            for (size_t k = s * SuperWords; k < std::min(wordCount, (s + 1) * SuperWords); k++)
+            {
+                wordRank[k] = uint16_t(ones - superRank[s]);
+
+                // Excess at all positions in the word relative to the excess
+                // before the word. Bit 0 is a step as well; hence, use the
+                // first position as reference and then add it.
+                uint64_t down = ~words[k];
+                size_t pos = bitArgminLast(down, 64);
+                int64_t first = (words[k] & 1) ? 1 : -1;
+
+                wordMin[k] = int8_t(first + bitExcess(down, pos));
+                superMin = std::min(superMin, wordBase(k) + wordMin[k]);
+
+                // Remember the superblock of every SelectStep-th '('.
+                size_t wordOnes = __builtin_popcountll(words[k]);
+                while (selectHint.size() * SelectStep < ones + wordOnes)
+                {
+                    selectHint.push_back(uint32_t(s));
+                }
+
+                ones += wordOnes;
+            }
+
+            // Unique keys; the smallest key is the last superblock with the
+            // smallest excess.
+            superKeys[s] = uint64_t(superMin + keyBias()) * superCount + (superCount - 1 - s);
+        }
+
+        superRmq.processData();
+    }
+
+    // Performs a query on the given data and given range.
+    // Returns the index of the minimum in that range.
+    // Behaviour is undefined if the given range is invalid or pre-processing
+    // has not been done.
+    size_t operator()(size_t i, size_t j) const
+    {
+        if (i == j) return i;
+
+        size_t a = select(i);
+        size_t b = select(j);
+
+        int64_t minVal;
+        size_t minPos = lastMin(a, b, minVal);
+
+        // See top of file.
+        if (minVal == excess(a)) return i;
+        else return rank(minPos + 1);
+    }
+
+    // Performs a query for each of the given ranges.
+    // See RMQ::batch() for details.
+    void batch(const std::pair<size_t, size_t>* ranges, size_t count, size_t* results) const
+    {
+        for (size_t q = 0; q < count; q++)
+        {
+            // Load the superblock hints of a later query into the cache.
+            if (q + this->BatchPrefetch < count)
+            {
+                const std::pair<size_t, size_t>& r = ranges[q + this->BatchPrefetch];
+
+                prefetch(&selectHint[r.first / SelectStep]);
+                prefetch(&selectHint[r.second / SelectStep]);
+            }
+
+            const std::pair<size_t, size_t>& r = ranges[q];
+            results[q] = SuccinctRMQ::operator()(r.first, r.second);
+        }
+    }
+
+
+private:
+
+    // The number of words in a superblock.
+    static constexpr size_t SuperWords = 8;
+
+    // The distance between '(' whose superblock is stored to speed up select.
+    static constexpr size_t SelectStep = 1024;
+
+
+    // The parentheses. Bit p of the sequence is bit p % 64 of words[p / 64].
+    // '(' is stored as 1 and ')' as 0.
+    vector<uint64_t> words;
+
+    // The number of '(' before each superblock.
+    vector<uint64_t> superRank;
+
+    // The number of '(' before each word within its superblock.
+    vector<uint16_t> wordRank;
+
+    // The smallest excess within each word relative to the excess before it.
+    vector<int8_t> wordMin;
+
+    // The smallest excess in each superblock combined with its index.
+    vector<uint64_t> superKeys;
+
+    // Finds the superblock with the smallest key.
+    SparseTableRMQ<uint64_t, uint32_t> superRmq;
+
+    // The superblock containing the (k * SelectStep)-th '(' for each k.
+    vector<uint32_t> selectHint;
+
+
+    // Returns a number that is larger than the absolute value of all excess
+    // values.
+    int64_t keyBias() const
+    {
+        return int64_t(2 * this->data.size() + 64);
+    }
+
+    // Returns the number of '(' before word k.
+    size_t onesBefore(size_t k) const
+    {
+        return superRank[k / SuperWords] + wordRank[k];
+    }
+
+    // Returns the excess before word k.
+    int64_t wordBase(size_t k) const
+    {
+        return 2 * int64_t(onesBefore(k)) - int64_t(64 * k);
+    }
+
+    // Returns the number of '(' in the positions 0, ..., p - 1.
+    size_t rank(size_t p) const
+    {
+        size_t k = p / 64;
+        uint64_t mask = (uint64_t(1) << (p & 63)) - 1;
+
+        return onesBefore(k) + __builtin_popcountll(words[k] & mask);
+    }
+
+    // Returns the excess after position p.
+    int64_t excess(size_t p) const
+    {
+        return 2 * int64_t(rank(p + 1)) - int64_t(p + 1);
+    }
+
+    // Returns the position of the r-th '(' (starting at 0).
+    size_t select(size_t r) const
+    {
+        // Find the last superblock with at most r '(' before it.
+        size_t lo = selectHint[r / SelectStep];
+        size_t hi = (r / SelectStep + 1 < selectHint.size()) ?
+            selectHint[r / SelectStep + 1] :
+            superRank.size() - 1;
+
+        while (lo < hi)
+        {
+            size_t mid = (lo + hi + 1) / 2;
+
+            if (superRank[mid] <= r) lo = mid;
+            else hi = mid - 1;
+        }
+
+        // Find the word.
+        size_t k = lo * SuperWords;
+        r -= superRank[lo];
+
+        while (k + 1 < wordRank.size() && (k + 1) % SuperWords != 0 && wordRank[k + 1] <= r) k++;
+
+        return 64 * k + bitSelect(words[k], r - wordRank[k]);
+    }
+
+    // Updates the current minimum if the minimum of positions
+    // 64k + lo, ..., 64k + hi is not larger.
+    void checkWord(size_t k, size_t lo, size_t hi, int64_t& minVal, size_t& minPos) const
+    {
+        size_t pos = 64 * k + lo + bitArgminLast(~words[k] >> lo, hi - lo + 1);
+        int64_t val = excess(pos);
+
+        if (val <= minVal)
+        {
+            minVal = val;
+            minPos = pos;
+        }
+    }
+
+    // Determines the last position with the smallest excess in [a, b].
+    // Returns that position and writes its excess into minVal.
+    size_t lastMin(size_t a, size_t b, int64_t& minVal) const
+    {
+        size_t wa = a / 64;
+        size_t wb = b / 64;
+
+        minVal = std::numeric_limits<int64_t>::max();
+        size_t minPos = a;
+
+        if (wa == wb)
+        {
+            checkWord(wa, a & 63, b & 63, minVal, minPos);
+            return minPos;
+        }
+
+        // The part of word wa in the range.
+        checkWord(wa, a & 63, 63, minVal, minPos);
+
+        // Full words and superblocks between wa and wb. Only the smallest
+        // (last) one is searched for its position.
+        size_t minWord = -1;
+        size_t k = wa + 1;
+
+        for (; k < wb && k % SuperWords != 0; k++)
+        {
+            if (wordBase(k) + wordMin[k] <= minVal)
+            {
+                minVal = wordBase(k) + wordMin[k];
+                minWord = k;
+            }
+        }
+
+        if (k + SuperWords <= wb)
+        {
+            size_t s = staticQuery(superRmq, k / SuperWords, wb / SuperWords - 1);
+            int64_t val = int64_t(superKeys[s] / superKeys.size()) - keyBias();
+
+            if (val <= minVal)
+            {
+                minVal = val;
+
+                // Find the last word with that minimum.
+                minWord = (s + 1) * SuperWords - 1;
+                while (wordBase(minWord) + wordMin[minWord] != val) minWord--;
+            }
+
+            k = (wb / SuperWords) * SuperWords;
+        }
+
+        for (; k < wb; k++)
+        {
+            if (wordBase(k) + wordMin[k] <= minVal)
+            {
+                minVal = wordBase(k) + wordMin[k];
+                minWord = k;
+            }
+        }
+
+        if (minWord != size_t(-1))
+        {
+            minVal = std::numeric_limits<int64_t>::max();
+            checkWord(minWord, 0, 63, minVal, minPos);
+        }
+
+        // The part of word wb in the range.
+        checkWord(wb, 0, b & 63, minVal, minPos);
+
+        return minPos;
+    }
+};
+
+#endif
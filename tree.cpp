@@ -1,43 +1,69 @@
 #include "tree.h"
 
+#include "parallel.hpp"
+
 
 using namespace std;
 
 
 // Default constructor.
 // Creates an empty tree.
-Tree::Tree() { /* Nothing. */ }
+template<typename Id>
+BasicTree<Id>::BasicTree() { /* Nothing. */ }
 
 // Constructor.
-Tree::Tree(const vector<size_t>& parList) :
+template<typename Id>
+BasicTree<Id>::BasicTree(const vector<Id>& parList) :
     parents(parList)
 {
     buildChildren();
 }
 
 // Constructor.
-Tree::Tree(vector<size_t>&& parList) :
+template<typename Id>
+BasicTree<Id>::BasicTree(vector<Id>&& parList) :
     parents(move(parList))
 {
     buildChildren();
 }
 
 
+// Returns the number of nodes.
+template<typename Id>
+size_t BasicTree<Id>::size() const
+{
+    return parents.size();
+}
+
+// Returns the ID of the root node.
+template<typename Id>
+Id BasicTree<Id>::getRoot() const
+{
+    return root;
+}
+
 // Returns the parent's ID of the given node.
-size_t Tree::operator()(size_t uId) const
+template<typename Id>
+Id BasicTree<Id>::operator()(size_t uId) const
 {
     return parents[uId];
 }
 
 // Returns the children of the given node.
-const vector<size_t>& Tree::operator[](size_t uId) const
+template<typename Id>
+Span<Id> BasicTree<Id>::operator[](size_t uId) const
 {
-    return children[uId];
+    return Span<Id>
+    (
+        children.data() + offsets[uId],
+        children.data() + offsets[uId + 1]
+    );
 }
 
 
 // Computes an Euler tour of the tree.
-EulerTour Tree::eulerTour() const
+template<typename Id>
+EulerTour BasicTree<Id>::eulerTour() const
 {
     const size_t n = parents.size();
 
@@ -47,8 +73,9 @@ EulerTour Tree::eulerTour() const
     result.R.resize(n);
 
     // Helpers to compute DFS
-    vector<size_t> chIdx(n, 0);
-    vector<size_t> stack;
+    // For each node, the position in children[] of the next child to visit.
+    vector<Id> chIdx(offsets.begin(), offsets.end() - 1);
+    vector<Id> stack;
 
 
     // Push
@@ -56,8 +83,8 @@ EulerTour Tree::eulerTour() const
 
     while (stack.size() > 0)
     {
-        size_t vId = stack.back();
-        size_t& cIdx = chIdx[vId];
+        Id vId = stack.back();
+        Id& cIdx = chIdx[vId];
 
 
         result.R[vId] = result.E.size();
@@ -65,9 +92,9 @@ EulerTour Tree::eulerTour() const
         result.L.push_back(stack.size());
 
 
-        if (cIdx < children[vId].size())
+        if (cIdx < offsets[vId + 1])
         {
-            const size_t& childId = children[vId][cIdx];
+            const Id& childId = children[cIdx];
 
             // Push
             stack.push_back(childId);
@@ -84,23 +111,278 @@ EulerTour Tree::eulerTour() const
 }
 
 
+// Computes an Euler tour of the tree that stores levels as steps.
+template<typename Id>
+CompactEulerTour BasicTree<Id>::compactEulerTour() const
+{
+    const size_t n = parents.size();
+    const size_t len = 2 * n - 1;
+
+    CompactEulerTour result;
+    result.E.resize(len);
+    result.steps.assign((len + 63) / 64, 0);
+    result.R.resize(n);
+
+    // Helpers to compute DFS, see eulerTour().
+    vector<Id> chIdx(offsets.begin(), offsets.end() - 1);
+    vector<Id> stack;
+
+    // Push
+    stack.push_back(root);
+
+    for (size_t k = 0; stack.size() > 0; k++)
+    {
+        Id vId = stack.back();
+        Id& cIdx = chIdx[vId];
+
+        result.R[vId] = uint32_t(k);
+        result.E[k] = uint32_t(vId);
+
+        if (cIdx < offsets[vId + 1])
+        {
+            // Push
+            stack.push_back(children[cIdx]);
+            cIdx++;
+        }
+        else
+        {
+            // All neighbours checked, backtrack. The next step goes up.
+            stack.pop_back();
+            if (k + 1 < len) result.steps[(k + 1) >> 6] |= uint64_t(1) << ((k + 1) & 63);
+        }
+    }
+
+    return result;
+}
+
+
+// Computes an Euler tour of the tree using up to the given number of threads.
+// The tour is a linked list of arcs (see arcSuccessors()). To place each arc,
+// the list is cut into sublists at every Step-th arc. Each thread walks some
+// sublists to determine their lengths and level changes. A sequential pass
+// over the sublists (in tour order) then determines where each of them starts,
+// and a second parallel walk writes E, L and R.
+template<typename Id>
+EulerTour BasicTree<Id>::eulerTour(size_t threads) const
+{
+    const size_t n = parents.size();
+
+    // A list of arcs only pays off for large trees.
+    if (threads <= 1 || n < (1 << 16)) return eulerTour();
+
+    // The arcs below assume a single root, i.e., n - 1 child nodes. For a
+    // forest, tour the tree of the root sequentially.
+    if (size_t(offsets[n]) + 1 != n) return eulerTour();
+
+    constexpr size_t Step = 256;
+    const size_t arcs = 2 * (n - 1);
+
+    const vector<Id> succ = arcSuccessors(threads);
+    const size_t firstArc = 2 * size_t(offsets[root]);
+
+
+    // --- Determine sublists. ---
+
+    // Sublist s < slots - 1 starts at arc s * Step. The last slot is used for
+    // the first arc of the tour if it is not already the start of a sublist.
+    const size_t slots = (arcs - 1) / Step + 2;
+
+    auto isHead = [&](size_t arc) { return arc % Step == 0 || arc == firstArc; };
+    auto slotOf = [&](size_t arc) { return arc % Step == 0 ? arc / Step : slots - 1; };
+
+    // The number of arcs, the level change, and the next sublist of each
+    // sublist.
+    vector<size_t> length(slots, 0);
+    vector<int64_t> delta(slots, 0);
+    constexpr size_t NoSlot = -1;
+    vector<size_t> next(slots, NoSlot);
+
+    parallelFor(0, slots, threads, 64, [&](size_t sta, size_t end)
+    {
+        for (size_t s = sta; s < end; s++)
+        {
+            size_t arc = s < slots - 1 ? s * Step : firstArc;
+            if (s == slots - 1 && firstArc % Step == 0) continue;
+
+            size_t len = 0;
+            int64_t lvl = 0;
+
+            do
+            {
+                len++;
+                lvl += (arc & 1) ? -1 : 1;
+                arc = succ[arc];
+            }
+            while (arc != NullNode && !isHead(arc));
+
+            length[s] = len;
+            delta[s] = lvl;
+            next[s] = arc != NullNode ? slotOf(arc) : NoSlot;
+        }
+    });
+
+
+    // --- Determine where each sublist starts. ---
+
+    // The position before the first arc of each sublist and its level.
+    vector<size_t> start(slots, 0);
+    vector<size_t> level(slots, 0);
+
+    for (size_t s = slotOf(firstArc), pos = 0, lvl = 1; s != NoSlot; s = next[s])
+    {
+        start[s] = pos;
+        level[s] = lvl;
+
+        pos += length[s];
+        lvl += delta[s];
+    }
+
+
+    // --- Write tour. ---
+
+    EulerTour result;
+    result.E.resize(2 * n - 1);
+    result.L.resize(2 * n - 1);
+    result.R.resize(n);
+
+    result.E[0] = root;
+    result.L[0] = 1;
+
+    parallelFor(0, slots, threads, 64, [&](size_t sta, size_t end)
+    {
+        for (size_t s = sta; s < end; s++)
+        {
+            if (length[s] == 0) continue;
+
+            size_t arc = s < slots - 1 ? s * Step : firstArc;
+            size_t pos = start[s];
+            size_t lvl = level[s];
+
+            for (size_t k = 0; k < length[s]; k++, arc = succ[arc])
+            {
+                size_t c = arc >> 1;
+                Id vId = arcHead(arc);
+
+                pos++;
+                lvl += (arc & 1) ? -1 : 1;
+
+                result.E[pos] = vId;
+                result.L[pos] = lvl;
+
+                // A node is visited the last time when entering a leaf or
+                // when returning from the last child.
+                if ((arc & 1) == 0)
+                {
+                    if (offsets[vId] == offsets[vId + 1]) result.R[vId] = pos;
+                }
+                else if (c + 1 == offsets[vId + 1])
+                {
+                    result.R[vId] = pos;
+                }
+            }
+        }
+    });
+
+    return result;
+}
+
+
+// Returns the node an arc leads to.
+template<typename Id>
+Id BasicTree<Id>::arcHead(size_t arc) const
+{
+    Id vId = children[arc >> 1];
+    return (arc & 1) ? parents[vId] : vId;
+}
+
+// Determines the arc that follows each arc in the tour. The last arc is
+// followed by NullNode.
+template<typename Id>
+std::vector<Id> BasicTree<Id>::arcSuccessors(size_t threads) const
+{
+    const size_t n = parents.size();
+    constexpr size_t Chunk = 1 << 14;
+
+    // The position of each node in children[].
+    vector<Id> position(n, NullNode);
+
+    parallelFor(0, children.size(), threads, Chunk, [&](size_t sta, size_t end)
+    {
+        for (size_t c = sta; c < end; c++) position[children[c]] = Id(c);
+    });
+
+    vector<Id> succ(2 * children.size());
+
+    parallelFor(0, children.size(), threads, Chunk, [&](size_t sta, size_t end)
+    {
+        for (size_t c = sta; c < end; c++)
+        {
+            Id vId = children[c];
+            Id pId = parents[vId];
+
+            // After going down to v, go down to its first child. If there is
+            // none, go back up.
+            succ[2 * c] = offsets[vId] < offsets[vId + 1] ?
+                Id(2 * offsets[vId]) :
+                Id(2 * c + 1);
+
+            // After going up from v, go down to its next sibling. If there is
+            // none, continue going up.
+            if (c + 1 < offsets[pId + 1]) succ[2 * c + 1] = Id(2 * c + 2);
+            else if (pId == root) succ[2 * c + 1] = NullNode;
+            else succ[2 * c + 1] = Id(2 * size_t(position[pId]) + 1);
+        }
+    });
+
+    return succ;
+}
+
+
 // Helper function for constructor.
-void Tree::buildChildren()
+// Stores the children of all nodes in one array: first count the children of
+// each node, then determine where they start, then place them.
+template<typename Id>
+void BasicTree<Id>::buildChildren()
 {
-    children.resize(parents.size());
+    const size_t n = parents.size();
+
+    // Count children. offsets[u + 1] is the number of children of u.
+    offsets.assign(n + 1, 0);
 
-    for (size_t uId = 0; uId < parents.size(); uId++)
+    for (size_t uId = 0; uId < n; uId++)
     {
-        size_t pId = parents[uId];
+        Id pId = parents[uId];
 
         if (pId == NullNode)
         {
-            root = uId;
+            root = Id(uId);
         }
         else
         {
-            children[pId].push_back(uId);
+            offsets[pId + 1]++;
         }
     }
+
+    // Prefix sums. offsets[u] is where the children of u start.
+    for (size_t uId = 0; uId < n; uId++)
+    {
+        offsets[uId + 1] += offsets[uId];
+    }
+
+    // Place children. next[u] is where the next child of u goes; it starts at
+    // offsets[u].
+    children.resize(n > 0 ? n - 1 : 0);
+
+    vector<Id> next(offsets.begin(), offsets.end() - 1);
+
+    for (size_t uId = 0; uId < n; uId++)
+    {
+        Id pId = parents[uId];
+        if (pId != NullNode) children[next[pId]++] = Id(uId);
+    }
 }
 
+
+// Supported ID types.
+template class BasicTree<size_t>;
+template class BasicTree<uint32_t>;
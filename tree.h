@@ -4,6 +4,7 @@
 #define __Tree_H__
 
 
+#include <cstdint>
 #include <vector>
 
 
@@ -20,7 +21,52 @@ struct EulerTour
 };
 
 
-class Tree
+// Represents an Euler tour with less memory. Instead of the levels, it stores
+// the steps between them: bit k of steps[k / 64] is set if L[k] = L[k - 1] - 1
+// (see bitRmq.hpp). The root has level 1. E and R use 32-bit integers; hence,
+// the tree has less than 2^31 nodes.
+struct CompactEulerTour
+{
+    // The sequence of nodes visited during an Euler tour.
+    std::vector<std::uint32_t> E;
+
+    // Whether each step of the tour goes up (towards the root).
+    std::vector<std::uint64_t> steps;
+
+    // The index of a node's last occurrence in the Euler tour.
+    std::vector<std::uint32_t> R;
+};
+
+
+// A read-only view of consecutive elements in an array.
+template<typename X>
+class Span
+{
+public:
+
+    // Constructor.
+    Span(const X* first, const X* last) : first(first), last(last) { /* Nothing. */ }
+
+
+    const X* begin() const { return first; }
+    const X* end() const { return last; }
+
+    std::size_t size() const { return last - first; }
+
+    const X& operator[](std::size_t idx) const { return first[idx]; }
+
+
+private:
+
+    const X* first;
+    const X* last;
+};
+
+
+// Represents a rooted tree. Nodes have the IDs 0, ..., n - 1, and Id is the
+// integer type used to store them.
+template<typename Id>
+class BasicTree
 {
     // Shortcut to avoid the need for "std::".
     template<typename X> using vector = std::vector<X>;
@@ -30,46 +76,81 @@ class Tree
 public:
 
     // Represents a null pointer.
-    static constexpr size_t NullNode = -1;
+    static constexpr Id NullNode = Id(-1);
 
 
     // Default constructor.
     // Creates an empty tree.
-    Tree();
+    BasicTree();
 
     // Constructor.
-    Tree(const vector<size_t>& parList);
+    BasicTree(const vector<Id>& parList);
 
     // Constructor.
-    Tree(vector<size_t>&& parList);
+    BasicTree(vector<Id>&& parList);
+
 
+    // Returns the number of nodes.
+    size_t size() const;
+
+    // Returns the ID of the root node.
+    Id getRoot() const;
 
     // Returns the parent's ID of the given node.
-    size_t operator()(size_t uId) const;
+    Id operator()(size_t uId) const;
 
     // Returns the children of the given node.
-    const vector<size_t>& operator[](size_t uId) const;
+    Span<Id> operator[](size_t uId) const;
 
 
     // Computes an Euler tour of the tree.
     EulerTour eulerTour() const;
 
+    // Computes an Euler tour of the tree using up to the given number of
+    // threads. The tour is the same as the one computed by eulerTour().
+    EulerTour eulerTour(size_t threads) const;
+
+    // Computes an Euler tour of the tree that stores levels as steps.
+    CompactEulerTour compactEulerTour() const;
+
 
 private:
 
     // The ID of the root node.
-    size_t root = NullNode;
+    Id root = NullNode;
 
     // The parents of each node.
-    vector<size_t> parents;
+    vector<Id> parents;
+
+    // The children of all nodes, ordered by parent. The children of node u
+    // are children[offsets[u]], ..., children[offsets[u + 1] - 1].
+    vector<Id> children;
 
-    // The children of each node.
-    vector<vector<size_t>> children;
+    // Where the children of each node start in children[].
+    vector<Id> offsets;
 
 
     // Helper function for constructors.
     void buildChildren();
 
+    // Helper functions for the parallel Euler tour. The child stored at
+    // children[c] has the arcs 2c (down from its parent) and 2c + 1 (up to its
+    // parent).
+
+    // Returns the node an arc leads to.
+    Id arcHead(size_t arc) const;
+
+    // Determines the arc that follows each arc in the tour.
+    vector<Id> arcSuccessors(size_t threads) const;
+
 };
 
+
+// A tree that can store any number of nodes.
+typedef BasicTree<std::size_t> Tree;
+
+// A tree with less than 2^31 nodes (the parallel Euler tour numbers the 2n
+// arcs of the tree with node IDs).
+typedef BasicTree<std::uint32_t> Tree32;
+
 #endif